@@ -0,0 +1,323 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+#include <Zut/ZxFS.h>
+
+
+// # Tree #
+namespace ZQF
+{
+    struct ZxBenchTree
+    {
+        std::size_t Depth{ 3 };
+        std::size_t Fanout{ 4 };
+        std::size_t FilesPerDir{ 32 };
+        std::size_t NameBytes{ 12 };
+        std::size_t FileBytes{ 256 };
+
+        auto DirCount() const -> std::size_t;
+        auto FileCount() const -> std::size_t;
+        auto Make(const std::filesystem::path& phRoot) const -> void;
+    };
+
+    static auto MakeName(const std::size_t nIndex, const std::size_t nBytes, const std::string_view msSuffix) -> std::string
+    {
+        auto name{ std::to_string(nIndex) };
+        if (name.size() < nBytes) { name.insert(0, nBytes - name.size(), 'n'); }
+        return name.append(msSuffix);
+    }
+
+    auto ZxBenchTree::DirCount() const -> std::size_t
+    {
+        std::size_t dir_count{ 1 }, level_count{ 1 };
+        for (std::size_t level{}; level < Depth; level++) { level_count *= Fanout; dir_count += level_count; }
+        return dir_count;
+    }
+
+    auto ZxBenchTree::FileCount() const -> std::size_t
+    {
+        return this->DirCount() * FilesPerDir;
+    }
+
+    auto ZxBenchTree::Make(const std::filesystem::path& phRoot) const -> void
+    {
+        const std::string file_data(FileBytes, 'z');
+
+        const std::function<void(const std::filesystem::path&, std::size_t)> make_dir = [&](const std::filesystem::path& phDir, const std::size_t nLevel)
+        {
+            std::filesystem::create_directories(phDir);
+
+            for (std::size_t index{}; index < FilesPerDir; index++)
+            {
+                std::ofstream{ phDir / MakeName(index, NameBytes, index % 2 ? ".bin" : ".txt"), std::ios::binary }.write(file_data.data(), static_cast<std::streamsize>(file_data.size()));
+            }
+
+            if (nLevel == Depth) { return; }
+            for (std::size_t index{}; index < Fanout; index++) { make_dir(phDir / MakeName(index, NameBytes, ""), nLevel + 1); }
+        };
+
+        make_dir(phRoot, 0);
+    }
+} // namespace ZQF
+
+
+// # Record #
+namespace ZQF
+{
+    struct ZxBenchResult
+    {
+        std::string Name;
+        std::string Impl;
+        std::size_t Items{};
+        std::vector<double> Samples; // ms
+    };
+
+    class ZxBench
+    {
+    private:
+        std::size_t m_nRepeat{};
+        std::vector<ZxBenchResult> m_vcResults;
+
+    public:
+        ZxBench(const std::size_t nRepeat) : m_nRepeat{ nRepeat } {}
+
+    public:
+        // fnSetup runs untimed before every sample, fnBody returns the item count it processed
+        auto Run(const std::string_view msName, const std::string_view msImpl, const std::function<void()>& fnSetup, const std::function<std::size_t()>& fnBody) -> void;
+        auto Dump(std::ostream& rfStream, const ZxBenchTree& rfTree) const -> void;
+    };
+
+    auto ZxBench::Run(const std::string_view msName, const std::string_view msImpl, const std::function<void()>& fnSetup, const std::function<std::size_t()>& fnBody) -> void
+    {
+        auto& result{ m_vcResults.emplace_back(std::string{ msName }, std::string{ msImpl }) };
+
+        for (std::size_t index{}; index < m_nRepeat; index++)
+        {
+            if (fnSetup) { fnSetup(); }
+            const auto beg{ std::chrono::steady_clock::now() };
+            result.Items = fnBody();
+            const auto end{ std::chrono::steady_clock::now() };
+            result.Samples.emplace_back(std::chrono::duration<double, std::milli>{ end - beg }.count());
+        }
+
+        std::cerr << msName << " [" << msImpl << "] " << result.Items << " items\n";
+    }
+
+    auto ZxBench::Dump(std::ostream& rfStream, const ZxBenchTree& rfTree) const -> void
+    {
+        rfStream << "{\n";
+        rfStream << "  \"tree\": { \"depth\": " << rfTree.Depth << ", \"fanout\": " << rfTree.Fanout << ", \"files_per_dir\": " << rfTree.FilesPerDir
+            << ", \"name_bytes\": " << rfTree.NameBytes << ", \"file_bytes\": " << rfTree.FileBytes << ", \"dirs\": " << rfTree.DirCount() << ", \"files\": " << rfTree.FileCount() << " },\n";
+        rfStream << "  \"repeat\": " << m_nRepeat << ",\n";
+        rfStream << "  \"results\": [\n";
+
+        for (std::size_t index{}; index < m_vcResults.size(); index++)
+        {
+            const auto& result{ m_vcResults[index] };
+            auto samples{ result.Samples };
+            std::ranges::sort(samples);
+            double total{};
+            for (const auto sample : samples) { total += sample; }
+
+            rfStream << "    { \"name\": \"" << result.Name << "\", \"impl\": \"" << result.Impl << "\", \"items\": " << result.Items
+                << ", \"min_ms\": " << samples.front() << ", \"median_ms\": " << samples[samples.size() / 2]
+                << ", \"mean_ms\": " << (total / static_cast<double>(samples.size())) << ", \"max_ms\": " << samples.back() << " }"
+                << (index + 1 == m_vcResults.size() ? "\n" : ",\n");
+        }
+
+        rfStream << "  ]\n}\n";
+    }
+} // namespace ZQF
+
+
+static auto ParseArg(const int argc, char** argv, const std::string_view msName, const std::size_t nDefault) -> std::size_t
+{
+    for (int index{ 1 }; index + 1 < argc; index++)
+    {
+        if (msName == argv[index]) { return static_cast<std::size_t>(std::strtoull(argv[index + 1], nullptr, 10)); }
+    }
+    return nDefault;
+}
+
+static auto ParseArg(const int argc, char** argv, const std::string_view msName, const std::string_view msDefault) -> std::string
+{
+    for (int index{ 1 }; index + 1 < argc; index++)
+    {
+        if (msName == argv[index]) { return argv[index + 1]; }
+    }
+    return std::string{ msDefault };
+}
+
+
+// usage: zxfs_bench [--depth n] [--fanout n] [--files n] [--name-bytes n] [--file-bytes n] [--repeat n] [--threads n] [--dir path] [--out file.json]
+auto main(int argc, char** argv) -> int
+{
+    try
+    {
+        ZQF::ZxBenchTree tree;
+        tree.Depth = ParseArg(argc, argv, "--depth", tree.Depth);
+        tree.Fanout = ParseArg(argc, argv, "--fanout", tree.Fanout);
+        tree.FilesPerDir = ParseArg(argc, argv, "--files", tree.FilesPerDir);
+        tree.NameBytes = ParseArg(argc, argv, "--name-bytes", tree.NameBytes);
+        tree.FileBytes = ParseArg(argc, argv, "--file-bytes", tree.FileBytes);
+        const auto repeat{ std::max<std::size_t>(ParseArg(argc, argv, "--repeat", 5), 1) };
+        const auto threads{ ParseArg(argc, argv, "--threads", 0) };
+        const auto out_path{ ParseArg(argc, argv, "--out", "") };
+        const auto parent_dir{ std::filesystem::path{ ParseArg(argc, argv, "--dir", std::filesystem::temp_directory_path().string()) } };
+
+        // only a fresh subdirectory of --dir is written to and deleted, never --dir itself
+        const auto bench_dir{ parent_dir / ("zxfs_bench_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count())) };
+        std::filesystem::create_directories(parent_dir);
+        if (std::filesystem::create_directory(bench_dir) == false) { throw std::runtime_error("bench dir already exists -> " + bench_dir.string()); }
+        const auto tree_dir{ bench_dir / "tree" };
+        const auto work_dir{ bench_dir / "work" };
+        const auto tree_dir_u8{ tree_dir.generic_string().append(1, '/') };
+        const auto work_dir_u8{ work_dir.generic_string().append(1, '/') };
+        tree.Make(tree_dir);
+        std::filesystem::create_directories(work_dir);
+
+        ZQF::ZxBench bench{ repeat };
+        const auto expect = [](const bool isStatus, const std::string_view msWhat) { if (isStatus == false) { throw std::runtime_error(std::string{ msWhat }.append(" failed")); } };
+
+        // search
+        bench.Run("search_recursive", "zxfs", {}, [&] { return ZxFS::Searcher::GetFilePaths(tree_dir_u8, true, true).size(); });
+        bench.Run("search_recursive", "zxfs_parallel", {}, [&] { return ZxFS::Searcher::GetFilePaths(tree_dir_u8, true, true, threads).size(); });
+        bench.Run("search_recursive", "zxfs_async", {}, [&] { return ZxFS::Searcher::GetFilePathsAsync(tree_dir_u8, true, 64).size(); });
+        bench.Run("search_recursive", "zxfs_path_list", {}, [&] { ZxFS::PathList paths; ZxFS::Searcher::GetFilePaths(paths, tree_dir_u8, true, true); return paths.size(); });
+        bench.Run("search_recursive", "zxfs_filter", {}, [&] { std::vector<std::string> paths; ZxFS::Searcher::GetFilePaths(paths, tree_dir_u8, true, true, ZxFS::Filter{ ".bin" }); return paths.size(); });
+        // the index distrusts directory stamps from the last seconds, age the fresh tree so warm runs measure reuse
+        const auto old_time{ std::filesystem::file_time_type::clock::now() - std::chrono::hours{ 1 } };
+        std::filesystem::last_write_time(tree_dir, old_time);
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{ tree_dir }) { if (entry.is_directory()) { std::filesystem::last_write_time(entry.path(), old_time); } }
+        ZxFS::ScanIndex scan_index;
+        scan_index.Update(tree_dir_u8);
+        bench.Run("search_recursive", "zxfs_index_warm", {}, [&] { std::vector<std::string> paths; scan_index.Update(tree_dir_u8); scan_index.GetFilePaths(paths, true); return paths.size(); });
+        bench.Run("search_recursive", "std_fs", {}, [&]
+            {
+                std::vector<std::string> paths;
+                for (const auto& entry : std::filesystem::recursive_directory_iterator{ tree_dir })
+                {
+                    if (entry.is_regular_file()) { paths.emplace_back(entry.path().generic_string()); }
+                }
+                return paths.size();
+            });
+
+        // size
+        bench.Run("dir_size", "zxfs_parallel", {}, [&] { return static_cast<std::size_t>(ZxFS::DirSize(tree_dir_u8, threads).value_or(ZxFS::DirUsage{}).FileCount); });
+        bench.Run("dir_size", "std_fs", {}, [&]
+            {
+                std::size_t file_count{};
+                std::uintmax_t total_bytes{};
+                for (const auto& entry : std::filesystem::recursive_directory_iterator{ tree_dir })
+                {
+                    if (entry.is_regular_file()) { total_bytes += entry.file_size(); file_count++; }
+                }
+                return total_bytes != 0 ? file_count : 0;
+            });
+
+        // walk
+        bench.Run("walk_recursive", "zxfs", {}, [&]
+            {
+                std::size_t file_count{};
+                std::vector<std::string> dir_stack{ tree_dir_u8 };
+                while (!dir_stack.empty())
+                {
+                    const auto dir{ std::move(dir_stack.back()) }; dir_stack.pop_back();
+                    for (ZxFS::Walker walk{ dir }; walk.Next(); )
+                    {
+                        if (walk.GetEntry().IsDir()) { dir_stack.emplace_back(walk.GetPath()); }
+                        else if (walk.GetEntry().IsFile()) { file_count++; }
+                    }
+                }
+                return file_count;
+            });
+        bench.Run("walk_recursive", "std_fs", {}, [&]
+            {
+                std::size_t file_count{};
+                std::vector<std::filesystem::path> dir_stack{ tree_dir };
+                while (!dir_stack.empty())
+                {
+                    const auto dir{ std::move(dir_stack.back()) }; dir_stack.pop_back();
+                    for (const auto& entry : std::filesystem::directory_iterator{ dir })
+                    {
+                        if (entry.is_directory()) { dir_stack.emplace_back(entry.path()); }
+                        else if (entry.is_regular_file()) { file_count++; }
+                    }
+                }
+                return file_count;
+            });
+
+        // copy
+        const auto copy_sources{ ZxFS::Searcher::GetFilePaths(tree_dir_u8, false, false) };
+        const auto copy_dir_u8{ work_dir_u8 + "copy/" };
+        const auto reset_copy_dir = [&] { std::filesystem::remove_all(copy_dir_u8); std::filesystem::create_directories(copy_dir_u8); };
+        bench.Run("file_copy", "zxfs", reset_copy_dir, [&]
+            {
+                for (const auto& name : copy_sources) { expect(ZxFS::FileCopy(tree_dir_u8 + name, copy_dir_u8 + name, false), "FileCopy"); }
+                return copy_sources.size();
+            });
+        bench.Run("file_copy", "std_fs", reset_copy_dir, [&]
+            {
+                for (const auto& name : copy_sources) { std::filesystem::copy_file(tree_dir_u8 + name, copy_dir_u8 + name, std::filesystem::copy_options::overwrite_existing); }
+                return copy_sources.size();
+            });
+
+        const auto reset_tree_copy_dir = [&] { std::filesystem::remove_all(work_dir_u8 + "tree_copy/"); };
+        bench.Run("dir_copy_recursive", "zxfs_parallel", reset_tree_copy_dir, [&] { expect(ZxFS::DirCopyRecursive(tree_dir_u8, work_dir_u8 + "tree_copy/", false, threads), "DirCopyRecursive"); return tree.FileCount(); });
+        bench.Run("dir_copy_recursive", "std_fs", reset_tree_copy_dir, [&] { std::filesystem::copy(tree_dir, work_dir / "tree_copy", std::filesystem::copy_options::recursive); return tree.FileCount(); });
+
+        // make
+        std::vector<std::string> make_dirs;
+        for (std::size_t index{}; index < tree.DirCount(); index++)
+        {
+            make_dirs.emplace_back(work_dir_u8 + "make/" + ZQF::MakeName(index % tree.Fanout, tree.NameBytes, "/") + ZQF::MakeName(index, tree.NameBytes, "/") + ZQF::MakeName(index, tree.NameBytes, "/"));
+        }
+        const auto reset_make_dir = [&] { std::filesystem::remove_all(work_dir_u8 + "make/"); };
+        bench.Run("dir_make_recursive", "zxfs", reset_make_dir, [&]
+            {
+                for (const auto& dir : make_dirs) { expect(ZxFS::DirMakeRecursive(dir), "DirMakeRecursive"); }
+                return make_dirs.size();
+            });
+        bench.Run("dir_make_recursive", "std_fs", reset_make_dir, [&]
+            {
+                for (const auto& dir : make_dirs) { std::filesystem::create_directories(dir); }
+                return make_dirs.size();
+            });
+
+        // delete
+        const auto delete_dir{ work_dir / "delete" };
+        const auto delete_dir_u8{ delete_dir.generic_string().append(1, '/') };
+        const auto reset_delete_dir = [&] { std::filesystem::remove_all(delete_dir); std::filesystem::copy(tree_dir, delete_dir, std::filesystem::copy_options::recursive); };
+        bench.Run("dir_delete_recursive", "zxfs", reset_delete_dir, [&] { expect(ZxFS::DirDeleteRecursive(delete_dir_u8), "DirDeleteRecursive"); return tree.FileCount(); });
+        bench.Run("dir_delete_recursive", "zxfs_parallel", reset_delete_dir, [&] { expect(ZxFS::DirDeleteRecursive(delete_dir_u8, threads), "DirDeleteRecursive"); return tree.FileCount(); });
+        bench.Run("dir_delete_recursive", "std_fs", reset_delete_dir, [&] { std::filesystem::remove_all(delete_dir); return tree.FileCount(); });
+
+        std::filesystem::remove_all(bench_dir);
+
+        if (out_path.empty())
+        {
+            bench.Dump(std::cout, tree);
+        }
+        else
+        {
+            std::ofstream out_stream{ out_path };
+            bench.Dump(out_stream, tree);
+        }
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << "std::exception: " << err.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,7 +1,16 @@
 #pragma once
 #include <Zut/ZxFS/Core.h>
+#include <Zut/ZxFS/MappedFile.h>
+#include <Zut/ZxFS/Entry.h>
 #include <Zut/ZxFS/Walker.h>
+#include <Zut/ZxFS/Watcher.h>
+#include <Zut/ZxFS/Filter.h>
 #include <Zut/ZxFS/Searcher.h>
+#include <Zut/ZxFS/PathList.h>
+#include <Zut/ZxFS/ScanIndex.h>
+#include <Zut/ZxFS/ScanCursor.h>
+#include <Zut/ZxFS/Dedupe.h>
+#include <Zut/ZxFS/Stats.h>
 
 
 namespace ZxFS
@@ -1,55 +1,110 @@
 #include "Core.h"
 #include "Plat.h"
+#include "Pool.h"
+#include "Probe.h"
+#include "Scratch.h"
+#include "Walker.h"
+#include <bit>
 #include <span>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <functional>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZXFS_CORE_SSE2
+#include <emmintrin.h>
+#endif
 
 
 namespace ZQF::Zut::ZxFS
 {
-    auto FileName(const std::string_view msPath) -> std::string_view
+    // last '/' and last '.' of one path, scanning 16 bytes per step from the end. a '.' only counts when it lies after the last '/'.
+    static auto PathSplitOne(const char* cpPath, const std::size_t nBytes) -> PathComponents
     {
-        const auto pos = msPath.rfind('/');
-        return pos != std::string_view::npos ? msPath.substr(pos + 1) : msPath;
-    }
+        std::size_t slash_pos{ std::string_view::npos }, dot_pos{ std::string_view::npos };
+        std::size_t tail{ nBytes };
 
-    auto FileNameStem(const std::string_view msPath) -> std::string_view
-    {
-        return ZxFS::FileSuffixDel(ZxFS::FileName(msPath));
-    }
-
-    auto FileSuffix(const std::string_view msPath) -> std::string_view
-    {
-        for (auto ite = std::rbegin(msPath); ite != std::rend(msPath); ite++)
+#if defined(ZXFS_CORE_SSE2)
+        const auto slash_vec{ _mm_set1_epi8('/') };
+        const auto dot_vec{ _mm_set1_epi8('.') };
+        while (tail >= 16)
         {
-            if (*ite == '/')
-            {
-                break;
-            }
-            else if (*ite == '.')
+            const auto chunk_beg{ tail - 16 };
+            const auto chunk_vec{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(cpPath + chunk_beg)) };
+            const auto slash_bits{ static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk_vec, slash_vec))) };
+            auto dot_bits{ static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk_vec, dot_vec))) };
+
+            if (slash_bits != 0)
             {
-                return msPath.substr(std::distance(ite, std::rend(msPath)) - 1);
+                const auto slash_bit{ static_cast<std::size_t>(31 - std::countl_zero(slash_bits)) };
+                slash_pos = chunk_beg + slash_bit;
+                dot_bits &= ~((std::uint32_t{ 2 } << slash_bit) - 1); // dots after the slash only
             }
+
+            if (dot_pos == std::string_view::npos && dot_bits != 0) { dot_pos = chunk_beg + static_cast<std::size_t>(31 - std::countl_zero(dot_bits)); }
+            if (slash_pos != std::string_view::npos) { return { slash_pos + 1, dot_pos == std::string_view::npos ? nBytes : dot_pos, nBytes }; }
+            tail = chunk_beg;
+        }
+#endif
+
+        while (tail > 0)
+        {
+            const auto c{ cpPath[--tail] };
+            if (c == '/') { slash_pos = tail; break; }
+            if (c == '.' && dot_pos == std::string_view::npos) { dot_pos = tail; }
         }
 
-        return { "", 0 };
+        return { slash_pos == std::string_view::npos ? 0 : slash_pos + 1, dot_pos == std::string_view::npos ? nBytes : dot_pos, nBytes };
     }
 
-    auto FileSuffixDel(const std::string_view msPath) -> std::string_view
+    auto PathSplit(const PathList& rfPaths, std::vector<PathComponents>& vcComponents) -> void
     {
-        for (auto ite = std::rbegin(msPath); ite != std::rend(msPath); ite++)
-        {
-            if (*ite == '/')
-            {
-                break;
-            }
-            else if (*ite == '.')
-            {
-                return msPath.substr(0, std::distance(ite, std::rend(msPath)) - 1);
-            }
-        }
+        vcComponents.reserve(vcComponents.size() + rfPaths.size());
+        for (const auto path : rfPaths) { vcComponents.emplace_back(ZxFS::PathSplitOne(path.data(), path.size())); }
+    }
+
+    auto PathSplit(const std::span<const std::string> spPaths, std::vector<PathComponents>& vcComponents) -> void
+    {
+        vcComponents.reserve(vcComponents.size() + spPaths.size());
+        for (const auto& path : spPaths) { vcComponents.emplace_back(ZxFS::PathSplitOne(path.data(), path.size())); }
+    }
 
-        return msPath;
+    auto PathSplit(const std::span<const std::string_view> spPaths, std::vector<PathComponents>& vcComponents) -> void
+    {
+        vcComponents.reserve(vcComponents.size() + spPaths.size());
+        for (const auto path : spPaths) { vcComponents.emplace_back(ZxFS::PathSplitOne(path.data(), path.size())); }
     }
-}
+} // namespace ZQF::Zut::ZxFS
+
+namespace ZQF::Zut::ZxFS
+{
+    // (dev, ino) of every multiply linked file already counted by DirSize
+    struct DirSizeLinks
+    {
+        std::mutex Locker;
+        std::set<std::pair<std::uint64_t, std::uint64_t>> Seen;
+    };
+
+    // per-path result of the batch functions, 0 or more on success, negative on failure
+    constexpr std::int32_t BATCH_PENDING{ std::numeric_limits<std::int32_t>::min() };
+
+    // one directory of the bulk DirMakeRecursive, nodes are kept in preorder so a subtree is [index, SubtreeEnd)
+    struct DirMakeNode
+    {
+        std::string_view Path; // the directory itself, with trailing '/'
+        std::size_t NameBeg{}; // Path[NameBeg, size - 1) is its name, empty for the filesystem root
+        std::size_t Depth{};
+        std::size_t SubtreeEnd{};
+    };
+} // namespace ZQF::Zut::ZxFS
+
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -107,23 +162,36 @@ namespace ZQF::Zut::ZxFS
 
     auto FileDelete(const std::string_view msPath) -> bool
     {
-        return ::DeleteFileW(Plat::PathUTF8ToWide(msPath).second.get()) != FALSE;
+        return ZXFS_STAT_CALL(Unlink, ::DeleteFileW(Plat::PathUTF8ToWide(msPath).second.get())) != FALSE;
     }
 
     auto FileMove(const std::string_view msExistPath, const std::string_view msNewPath) -> bool
     {
+        ZXFS_STAT_INC(Rename);
         return ::MoveFileW(Plat::PathUTF8ToWide(msExistPath).second.get(), Plat::PathUTF8ToWide(msNewPath).second.get()) != FALSE;
     }
 
-    auto FileCopy(const std::string_view msExistPath, const std::string_view msNewPath, bool isFailIfExists) -> bool
+    auto FileCopy(const std::string_view msExistPath, const std::string_view msNewPath, bool isFailIfExists, const std::uint32_t /* nFlags */) -> bool
     {
-        return ::CopyFileW(Plat::PathUTF8ToWide(msExistPath).second.get(), Plat::PathUTF8ToWide(msNewPath).second.get(), isFailIfExists ? TRUE : FALSE) != FALSE;
+        // CopyFileW already clones blocks on ReFS / Dev Drive and keeps sparse attributes
+        ZXFS_STAT_PHASE(Copy);
+        ZXFS_STAT_INC(CopyCall);
+        const auto exist_path_w{ Plat::PathUTF8ToWide(msExistPath) };
+        const auto new_path_w{ Plat::PathUTF8ToWide(msNewPath) };
+        if (::CopyFileW(exist_path_w.second.get(), new_path_w.second.get(), isFailIfExists ? TRUE : FALSE) != FALSE) { return true; }
+
+        // read-only target, e.g. an earlier copy of a read-only source: replace it like the linux side does
+        const auto new_attributes{ ::GetFileAttributesW(new_path_w.second.get()) };
+        if (isFailIfExists || new_attributes == INVALID_FILE_ATTRIBUTES || (new_attributes & FILE_ATTRIBUTE_READONLY) == 0) { return false; }
+        if (::SetFileAttributesW(new_path_w.second.get(), new_attributes ^ FILE_ATTRIBUTE_READONLY) == FALSE) { return false; }
+        ZXFS_STAT_INC(CopyCall);
+        return ::CopyFileW(exist_path_w.second.get(), new_path_w.second.get(), FALSE) != FALSE;
     }
 
     auto FileSize(const std::string_view msPath) -> std::optional<std::uint64_t>
     {
         WIN32_FILE_ATTRIBUTE_DATA find_data;
-        const auto status = ::GetFileAttributesExW(Plat::PathUTF8ToWide(msPath).second.get(), GetFileExInfoStandard, &find_data);
+        const auto status = ZXFS_STAT_CALL(Stat, ::GetFileAttributesExW(Plat::PathUTF8ToWide(msPath).second.get(), GetFileExInfoStandard, &find_data));
         if (status == FALSE) { return std::nullopt; }
         const auto size_l = static_cast<std::uint64_t>(find_data.nFileSizeLow);
         const auto size_h = static_cast<std::uint64_t>(find_data.nFileSizeHigh);
@@ -132,15 +200,16 @@ namespace ZQF::Zut::ZxFS
 
     static auto DirContentDeleteImp(const std::string_view msBasePath, const bool isRemoveBaseDir) -> bool
     {
+        ZXFS_STAT_PHASE(Delete);
         std::stack<std::wstring> search_dir_stack;
         search_dir_stack.push(L"*");
 
-        const auto path_cache{ std::make_unique_for_overwrite<wchar_t[]>(PATH_MAX_BYTES / sizeof(wchar_t)) };
+        Scratch::PathBuffer path_cache{ PATH_MAX_BYTES };
 
-        const auto base_dir_chars{ Plat::PathUTF8ToWide(msBasePath, path_cache.get(), PATH_MAX_BYTES / sizeof(wchar_t)) };
+        const auto base_dir_chars{ Plat::PathUTF8ToWide(msBasePath, path_cache.Data<wchar_t>(), PATH_MAX_BYTES / sizeof(wchar_t)) };
         if (base_dir_chars == 0) { return false; }
 
-        wchar_t* cur_path_ptr{ path_cache.get() };
+        wchar_t* cur_path_ptr{ path_cache.Data<wchar_t>() };
 
         do
         {
@@ -158,13 +227,14 @@ namespace ZQF::Zut::ZxFS
             // remove the empty directory.
             if (search_dir_name.ends_with(L'/'))
             {
-                ::RemoveDirectoryW(cur_path_ptr);
+                ZXFS_STAT_CALL(Unlink, ::RemoveDirectoryW(cur_path_ptr));
                 continue;
             }
 
             WIN32_FIND_DATAW find_data;
-            const auto hfind{ ::FindFirstFileExW(cur_path_ptr, FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0) };
+            const auto hfind{ ZXFS_STAT_CALL(OpenDir, ::FindFirstFileExW(cur_path_ptr, FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0)) };
             if (hfind == INVALID_HANDLE_VALUE) { return false; }
+            ZXFS_STAT_INC(DirVisited);
 
             bool is_save_search_dir{ true };
 
@@ -172,6 +242,7 @@ namespace ZQF::Zut::ZxFS
             {
                 if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
                 if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+                ZXFS_STAT_INC(EntrySeen);
 
                 const auto file_name_chars = ::wcslen(find_data.cFileName);
 
@@ -202,7 +273,7 @@ namespace ZQF::Zut::ZxFS
                     // remove read-only attribute
                     if (find_data.dwFileAttributes & FILE_ATTRIBUTE_READONLY) { ::SetFileAttributesW(cur_path_ptr, find_data.dwFileAttributes ^ FILE_ATTRIBUTE_READONLY); }
 
-                    ::DeleteFileW(cur_path_ptr);
+                    ZXFS_STAT_CALL(Unlink, ::DeleteFileW(cur_path_ptr));
                 }
             } while (::FindNextFileW(hfind, &find_data));
 
@@ -212,7 +283,7 @@ namespace ZQF::Zut::ZxFS
             if (is_save_search_dir == true)
             {
                 cur_path_ptr[cur_path_chars - 1] = L'\0';
-                ::RemoveDirectoryW(cur_path_ptr);
+                ZXFS_STAT_CALL(Unlink, ::RemoveDirectoryW(cur_path_ptr));
             }
 
         } while (!search_dir_stack.empty());
@@ -221,12 +292,95 @@ namespace ZQF::Zut::ZxFS
         if (isRemoveBaseDir)
         {
             cur_path_ptr[base_dir_chars] = L'\0';
-            return ::RemoveDirectoryW(cur_path_ptr) != FALSE;
+            return ZXFS_STAT_CALL(Unlink, ::RemoveDirectoryW(cur_path_ptr)) != FALSE;
         }
 
         return true;
     }
 
+    static auto DirClearFiles(const std::string& msDirPath, std::vector<std::string>& vcSubDirNames) -> bool
+    {
+        const auto [search_path_w, search_path_w_buffer] = Plat::PathUTF8ToWide(std::string{ msDirPath }.append(1, '*'));
+
+        WIN32_FIND_DATAW find_data;
+        const auto hfind{ ZXFS_STAT_CALL(OpenDir, ::FindFirstFileExW(search_path_w_buffer.get(), FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0)) };
+        if (hfind == INVALID_HANDLE_VALUE) { return false; }
+        ZXFS_STAT_INC(DirVisited);
+
+        Scratch::PathBuffer path_cache{ PATH_MAX_BYTES };
+        wchar_t* file_path_cache{ path_cache.Data<wchar_t>() };
+        const auto dir_path_chars{ search_path_w.size() - 1 };
+        std::memcpy(file_path_cache, search_path_w.data(), dir_path_chars * sizeof(wchar_t));
+
+        do
+        {
+            if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
+            if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+            ZXFS_STAT_INC(EntrySeen);
+
+            if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                vcSubDirNames.emplace_back(Plat::PathWideToUTF8(find_data.cFileName).first);
+            }
+            else
+            {
+                const auto file_name_chars{ ::wcslen(find_data.cFileName) };
+                if ((dir_path_chars + file_name_chars) >= (PATH_MAX_BYTES / sizeof(wchar_t))) { continue; }
+                std::memcpy(file_path_cache + dir_path_chars, find_data.cFileName, (file_name_chars + 1) * sizeof(wchar_t));
+
+                // remove read-only attribute
+                if (find_data.dwFileAttributes & FILE_ATTRIBUTE_READONLY) { ::SetFileAttributesW(file_path_cache, find_data.dwFileAttributes ^ FILE_ATTRIBUTE_READONLY); }
+
+                ZXFS_STAT_CALL(Unlink, ::DeleteFileW(file_path_cache));
+            }
+        } while (::FindNextFileW(hfind, &find_data));
+
+        ::FindClose(hfind);
+
+        return true;
+    }
+
+    static auto DirRemoveEmpty(const std::string& msDirPath) -> bool
+    {
+        return ZXFS_STAT_CALL(Unlink, ::RemoveDirectoryW(Plat::PathUTF8ToWide(msDirPath).second.get())) != FALSE;
+    }
+
+    static auto DirSizeList(const std::string& msDirPath, DirUsage& rfUsage, std::vector<std::string>& vcSubDirNames, DirSizeLinks& /* rfLinks */) -> bool
+    {
+        // the find data has no link count or allocation size, allocated is approximated by 4 KiB clusters
+        const auto [search_path_w, search_path_w_buffer] = Plat::PathUTF8ToWide(std::string{ msDirPath }.append(1, '*'));
+
+        WIN32_FIND_DATAW find_data;
+        const auto hfind{ ZXFS_STAT_CALL(OpenDir, ::FindFirstFileExW(search_path_w_buffer.get(), FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0)) };
+        if (hfind == INVALID_HANDLE_VALUE) { return false; }
+        ZXFS_STAT_INC(DirVisited);
+
+        rfUsage.DirCount++;
+
+        do
+        {
+            if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
+            if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+            ZXFS_STAT_INC(EntrySeen);
+
+            if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                vcSubDirNames.emplace_back(Plat::PathWideToUTF8(find_data.cFileName).first);
+            }
+            else
+            {
+                const auto file_bytes{ (static_cast<std::uint64_t>(find_data.nFileSizeHigh) << 32) | find_data.nFileSizeLow };
+                rfUsage.ApparentBytes += file_bytes;
+                rfUsage.AllocatedBytes += (file_bytes + 0xFFF) & ~std::uint64_t{ 0xFFF };
+                rfUsage.FileCount++;
+            }
+        } while (::FindNextFileW(hfind, &find_data));
+
+        ::FindClose(hfind);
+
+        return true;
+    }
+
     auto DirContentDelete(const std::string_view msPath) -> bool
     {
         if (!msPath.ends_with('/')) { return false; }
@@ -236,7 +390,7 @@ namespace ZQF::Zut::ZxFS
     auto DirDelete(const std::string_view msPath) -> bool
     {
         if (!msPath.ends_with('/')) { return false; }
-        return ::RemoveDirectoryW(Plat::PathUTF8ToWide(msPath).second.get()) != FALSE;
+        return ZXFS_STAT_CALL(Unlink, ::RemoveDirectoryW(Plat::PathUTF8ToWide(msPath).second.get())) != FALSE;
     }
 
     auto DirDeleteRecursive(const std::string_view msPath) -> bool
@@ -248,6 +402,7 @@ namespace ZQF::Zut::ZxFS
     {
         if (!msPath.ends_with('/')) { return false; }
         const auto path_w = Plat::PathUTF8ToWide(msPath);
+        ZXFS_STAT_INC(MakeDir);
         return ::CreateDirectoryW(path_w.second.get(), nullptr) != FALSE;
     }
 
@@ -255,6 +410,7 @@ namespace ZQF::Zut::ZxFS
     {
         if (!msPath.ends_with('/')) { return false; }
 
+        ZXFS_STAT_PHASE(Make);
         const auto path_w = Plat::PathUTF8ToWide(msPath);
         wchar_t* path_cstr = path_w.second.get();
         const wchar_t* path_cstr_org = path_cstr;
@@ -264,8 +420,9 @@ namespace ZQF::Zut::ZxFS
             if (*path_cstr != L'/') { continue; }
 
             *path_cstr = {};
-            if (::GetFileAttributesW(path_cstr_org) == INVALID_FILE_ATTRIBUTES)
+            if (ZXFS_STAT_CALL(Stat, ::GetFileAttributesW(path_cstr_org)) == INVALID_FILE_ATTRIBUTES)
             {
+                ZXFS_STAT_INC(MakeDir);
                 ::CreateDirectoryW(path_cstr_org, nullptr);
             }
             *path_cstr = L'/';
@@ -275,16 +432,60 @@ namespace ZQF::Zut::ZxFS
         return true;
     }
 
+    // makes vcNodes[nBeg, nEnd) in preorder, nodes deeper than nMaxDepth are left to later calls
+    static auto DirMakeSubtree(const std::vector<DirMakeNode>& vcNodes, const std::size_t nBeg, const std::size_t nEnd, const std::size_t nMaxDepth) -> bool
+    {
+        bool is_all_made{ true };
+        for (auto index{ nBeg }; index < nEnd; )
+        {
+            const auto& node{ vcNodes[index] };
+            const auto path_w = Plat::PathUTF8ToWide(node.Path);
+
+            ZXFS_STAT_INC(MakeDir);
+            bool is_made{ ::CreateDirectoryW(path_w.second.get(), nullptr) != FALSE };
+            if (is_made == false)
+            {
+                const auto attributes{ ZXFS_STAT_CALL(Stat, ::GetFileAttributesW(path_w.second.get())) };
+                is_made = (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+            }
+
+            if (is_made == false) { is_all_made = false; }
+            index = (is_made == false || node.Depth >= nMaxDepth) ? node.SubtreeEnd : index + 1;
+        }
+        return is_all_made;
+    }
+
     auto Exist(const std::string_view msPath) -> bool
     {
-        return ::GetFileAttributesW(Plat::PathUTF8ToWide(msPath).second.get()) == INVALID_FILE_ATTRIBUTES ? false : true;
+        return ZXFS_STAT_CALL(Stat, ::GetFileAttributesW(Plat::PathUTF8ToWide(msPath).second.get())) == INVALID_FILE_ATTRIBUTES ? false : true;
+    }
+
+    // no io_uring here, the whole batch is left to BatchRunPending
+    static auto FileDeleteQueued(const std::span<const std::string> /* spPaths */, const std::size_t /* nQueueDepth */, std::vector<std::int32_t>& /* vcResults */) -> void
+    {
+
+    }
+
+    static auto FileMoveQueued(const std::span<const std::string> /* spExistPaths */, const std::span<const std::string> /* spNewPaths */, const std::size_t /* nQueueDepth */, std::vector<std::int32_t>& /* vcResults */) -> void
+    {
+
+    }
+
+    static auto FileStatQueued(const std::span<const std::string> /* spPaths */, const std::size_t /* nQueueDepth */, std::vector<std::int32_t>& /* vcResults */, std::vector<std::optional<std::uint64_t>>* /* pSizes */) -> void
+    {
+
     }
 } // namespace ZQF::Zut::ZxFS
 #elif __linux__
+#include "Uring.h"
 #include <unistd.h>
 #include <fcntl.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+#include <cerrno>
 #include <cstring>
 
 
@@ -333,121 +534,319 @@ namespace ZQF::Zut::ZxFS
 
     auto FileDelete(const std::string_view msPath) -> bool
     {
-        return ::remove(msPath.data()) != -1;
+        return ZXFS_STAT_CALL(Unlink, ::remove(msPath.data())) != -1;
     }
 
     auto FileMove(const std::string_view msExistPath, const std::string_view msNewPath) -> bool
     {
+        ZXFS_STAT_INC(Rename);
         return ::rename(msExistPath.data(), msNewPath.data()) != -1;
     }
 
-    auto FileCopy(const std::string_view msExistPath, const std::string_view msNewPath, bool isFailIfExists) -> bool
+    static auto FileCopyRangeFallback(const int nExistFD, const int nNewFD, off_t nOffset, std::size_t nBytes) -> bool
+    {
+        if (::lseek(nNewFD, nOffset, SEEK_SET) == -1) { return false; }
+
+        while (nBytes > 0)
+        {
+            ZXFS_STAT_INC(CopyCall);
+            const auto send_bytes{ ::sendfile(nNewFD, nExistFD, &nOffset, nBytes) };
+            if (send_bytes == -1) { break; }
+            if (send_bytes == 0) { return false; }
+            ZXFS_STAT_ADD(BytesCopied, send_bytes);
+            nBytes -= static_cast<std::size_t>(send_bytes);
+        }
+
+        if (nBytes == 0) { return true; }
+
+        // sendfile refused, plain read / write for the remainder
+        char buffer[0x10000];
+        while (nBytes > 0)
+        {
+            ZXFS_STAT_INC(CopyCall);
+            const auto read_bytes{ ::pread(nExistFD, buffer, std::min(nBytes, sizeof(buffer)), nOffset) };
+            if (read_bytes <= 0) { return false; }
+            for (ssize_t written_bytes{}; written_bytes < read_bytes; )
+            {
+                ZXFS_STAT_INC(CopyCall);
+                const auto write_bytes{ ::pwrite(nNewFD, buffer + written_bytes, static_cast<std::size_t>(read_bytes - written_bytes), nOffset + written_bytes) };
+                if (write_bytes == -1) { return false; }
+                ZXFS_STAT_ADD(BytesCopied, write_bytes);
+                written_bytes += write_bytes;
+            }
+            nOffset += read_bytes;
+            nBytes -= static_cast<std::size_t>(read_bytes);
+        }
+
+        return true;
+    }
+
+    static auto FileCopyRange(const int nExistFD, const int nNewFD, const off_t nOffset, const std::size_t nBytes, const std::uint32_t nFlags) -> bool
+    {
+        if ((nFlags & FileCopyFlag::Preallocate) && (nBytes != 0)) { ::fallocate(nNewFD, 0, nOffset, static_cast<off_t>(nBytes)); } // only a hint, failure is fine
+
+        loff_t offset_exist{ nOffset }, offset_new{ nOffset };
+        auto remain_bytes{ nBytes };
+        while (remain_bytes > 0)
+        {
+            ZXFS_STAT_INC(CopyCall);
+            const auto cp_bytes{ ::copy_file_range(nExistFD, &offset_exist, nNewFD, &offset_new, remain_bytes, 0) };
+            if (cp_bytes == -1)
+            {
+                const auto err{ errno };
+                if (err == EXDEV || err == EINVAL || err == ENOSYS || err == EOPNOTSUPP || err == EBADF) { return ZxFS::FileCopyRangeFallback(nExistFD, nNewFD, offset_exist, remain_bytes); }
+                return false;
+            }
+            if (cp_bytes == 0) { return false; } // source shrank under us
+            ZXFS_STAT_ADD(BytesCopied, cp_bytes);
+            remain_bytes -= static_cast<std::size_t>(cp_bytes);
+        }
+
+        return true;
+    }
+
+    static auto FileCopyData(const int nExistFD, const int nNewFD, const off_t nSize, const std::uint32_t nFlags) -> bool
     {
-        const auto fd_exist = ::open(msExistPath.data(), O_RDONLY);
+        if (nSize == 0) { return true; }
+
+        if (nFlags & FileCopyFlag::Reflink)
+        {
+            ZXFS_STAT_INC(CopyCall);
+            if (::ioctl(nNewFD, FICLONE, nExistFD) == 0) { ZXFS_STAT_ADD(BytesCopied, nSize); return true; }
+        }
+
+        if ((nFlags & FileCopyFlag::Sparse) == 0) { return ZxFS::FileCopyRange(nExistFD, nNewFD, 0, static_cast<std::size_t>(nSize), nFlags); }
+
+        for (off_t data_beg{}; data_beg < nSize; )
+        {
+            data_beg = ::lseek(nExistFD, data_beg, SEEK_DATA);
+            if (data_beg == -1)
+            {
+                if (errno == ENXIO) { break; } // only a hole left
+                return ZxFS::FileCopyRange(nExistFD, nNewFD, 0, static_cast<std::size_t>(nSize), nFlags); // SEEK_DATA unsupported
+            }
+
+            auto data_end{ ::lseek(nExistFD, data_beg, SEEK_HOLE) };
+            if (data_end == -1 || data_end > nSize) { data_end = nSize; }
+
+            if (ZxFS::FileCopyRange(nExistFD, nNewFD, data_beg, static_cast<std::size_t>(data_end - data_beg), nFlags) == false) { return false; }
+            data_beg = data_end;
+        }
+
+        // trailing hole
+        return ::ftruncate(nNewFD, nSize) != -1;
+    }
+
+    auto FileCopy(const std::string_view msExistPath, const std::string_view msNewPath, bool isFailIfExists, const std::uint32_t nFlags) -> bool
+    {
+        ZXFS_STAT_PHASE(Copy);
+        ZXFS_STAT_INC(OpenFile);
+        const auto fd_exist = ::open(msExistPath.data(), O_RDONLY | O_CLOEXEC);
         if (fd_exist == -1)
         {
             return false;
         }
 
-        const auto fd_new = ::open(msNewPath.data(), isFailIfExists ? O_CREAT | O_WRONLY | O_EXCL : O_CREAT | O_WRONLY | O_TRUNC, 0777);
-        if (fd_new == -1)
+        struct stat st;
+        const auto fstat_status = ZXFS_STAT_CALL(Stat, ::fstat(fd_exist, &st));
+        if (fstat_status == -1)
         {
             ::close(fd_exist);
             return false;
         }
 
-        struct stat st;
-        const auto fstat_status = ::fstat(fd_exist, &st);
-        if (fstat_status == -1)
+        // created owner-writable (umask still applies) so the data can go in, a read-only source mode is applied afterwards
+        const auto file_mode{ static_cast<mode_t>(st.st_mode & 07777) };
+        ZXFS_STAT_INC(OpenFile);
+        auto fd_new = ::open(msNewPath.data(), isFailIfExists ? O_CREAT | O_WRONLY | O_EXCL | O_CLOEXEC : O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, file_mode | S_IWUSR);
+        if (fd_new == -1 && errno == EACCES && isFailIfExists == false)
+        {
+            // read-only target, e.g. an earlier copy of a read-only source: replace it like cp -f
+            if (ZXFS_STAT_CALL(Unlink, ::unlink(msNewPath.data())) != -1) { ZXFS_STAT_INC(OpenFile); fd_new = ::open(msNewPath.data(), O_CREAT | O_WRONLY | O_EXCL | O_CLOEXEC, file_mode | S_IWUSR); }
+        }
+        if (fd_new == -1)
         {
             ::close(fd_exist);
-            ::close(fd_new);
             return false;
         }
 
-        ssize_t cp_bytes{};
-        auto remain_bytes = st.st_size;
-        do
+        auto status{ ZxFS::FileCopyData(fd_exist, fd_new, st.st_size, nFlags) };
+        if (status && (file_mode & S_IWUSR) == 0)
         {
-            cp_bytes = ::copy_file_range(fd_exist, 0, fd_new, 0, remain_bytes, 0);
-            if (cp_bytes == -1) { break; }
-            remain_bytes -= cp_bytes;
-        } while (remain_bytes > 0 && cp_bytes > 0);
+            struct stat st_new;
+            status = (ZXFS_STAT_CALL(Stat, ::fstat(fd_new, &st_new)) != -1) && (::fchmod(fd_new, (st_new.st_mode & 07777) & ~S_IWUSR) != -1);
+        }
 
         ::close(fd_exist);
         ::close(fd_new);
-        return remain_bytes == 0 ? true : false;
+        return status;
     }
 
     auto FileSize(const std::string_view msPath) -> std::optional<std::uint64_t>
     {
         struct stat st;
-        const auto status = ::stat(msPath.data(), &st);
-        return (status != -1) ? std::optional{ static_cast<std::uint16_t>(st.st_size) } : std::nullopt;
+        const auto status = ZXFS_STAT_CALL(Stat, ::stat(msPath.data(), &st));
+        return (status != -1) ? std::optional{ static_cast<std::uint64_t>(st.st_size) } : std::nullopt;
     }
 
-    static auto DirContentDeleteImp(const std::string_view msPath, const std::size_t nPathMaxBytes) -> bool
+    struct DeleteDirFrame
+    {
+        int DirFD{ -1 };
+        std::string DirName{};
+        std::vector<std::string> SubDirNames{};
+    };
+
+    static auto DirContentDeleteImp(const std::string_view msPath) -> bool
     {
-        if (msPath.size() >= nPathMaxBytes) { return false; }
+        ZXFS_STAT_PHASE(Delete);
+        // unlinkat / AT_REMOVEDIR relative to the parent fd, only the fds along the current branch stay open.
+        std::vector<DeleteDirFrame> delete_dir_frames;
+        Plat::DirReader dir_reader;
+
+        const auto clear_dir = [&](const int nDirFD, std::string&& msDirName)
+        {
+            auto& frame{ delete_dir_frames.emplace_back(nDirFD, std::move(msDirName)) };
+
+            dir_reader.Attach(nDirFD);
+            while (dir_reader.Next())
+            {
+                const auto entry_name{ dir_reader.GetName() };
+
+                if (dir_reader.GetType() == DT_DIR)
+                {
+                    frame.SubDirNames.emplace_back(entry_name);
+                }
+                else
+                {
+                    if (ZXFS_STAT_CALL(Unlink, ::unlinkat(nDirFD, entry_name.data(), 0)) == -1 && errno == EISDIR)
+                    {
+                        frame.SubDirNames.emplace_back(entry_name); // DT_UNKNOWN directory
+                    }
+                }
+            }
+            dir_reader.Detach();
+        };
+
+        const auto base_dir_fd{ ZXFS_STAT_CALL(OpenDir, ::open(msPath.data(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)) };
+        if (base_dir_fd == -1) { return false; }
+        clear_dir(base_dir_fd, {});
 
-        auto path_buffer = std::make_unique_for_overwrite<char[]>(nPathMaxBytes);
+        while (!delete_dir_frames.empty())
         {
-            std::memcpy(path_buffer.get(), msPath.data(), msPath.size() * sizeof(char));
-            path_buffer[msPath.size()] = '\0';
+            auto& frame{ delete_dir_frames.back() };
+
+            if (frame.SubDirNames.empty())
+            {
+                const auto dir_name{ std::move(frame.DirName) };
+                const auto status{ ::close(frame.DirFD) };
+                delete_dir_frames.pop_back();
+                if (delete_dir_frames.empty()) { return status != -1; }
+                ZXFS_STAT_CALL(Unlink, ::unlinkat(delete_dir_frames.back().DirFD, dir_name.c_str(), AT_REMOVEDIR));
+                continue;
+            }
+
+            auto sub_dir_name{ std::move(frame.SubDirNames.back()) }; frame.SubDirNames.pop_back();
+            const auto sub_dir_fd{ ZXFS_STAT_CALL(OpenDir, ::openat(frame.DirFD, sub_dir_name.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)) };
+            if (sub_dir_fd == -1)
+            {
+                for (const auto& opened_frame : delete_dir_frames) { ::close(opened_frame.DirFD); }
+                return false;
+            }
+
+            clear_dir(sub_dir_fd, std::move(sub_dir_name));
         }
 
-        const auto dir_ptr = ::opendir(path_buffer.get());
-        if (dir_ptr == nullptr) { return false; }
+        return true;
+    }
 
-        while (const auto entry_ptr = ::readdir(dir_ptr))
+    static auto DirClearFiles(const std::string& msDirPath, std::vector<std::string>& vcSubDirNames) -> bool
+    {
+        thread_local Plat::DirReader dir_reader;
+        if (dir_reader.Open(msDirPath.c_str()) == false) { return false; }
+
+        const auto dir_fd{ dir_reader.GetFD() };
+        while (dir_reader.Next())
         {
-            if ((*reinterpret_cast<std::uint16_t*>(entry_ptr->d_name)) == std::uint32_t(0x002E)) { continue; }
-            if (((*reinterpret_cast<std::uint32_t*>(entry_ptr->d_name)) & 0x00FFFFFF) == std::uint32_t(0x00002E2E)) { continue; }
+            const auto entry_name{ dir_reader.GetName() };
 
-            const std::string_view name{ entry_ptr->d_name };
-            const auto path_bytes = msPath.size() + name.size();
-            if ((path_bytes + 1) >= nPathMaxBytes) { return false; }
-            std::memcpy(path_buffer.get() + msPath.size(), name.data(), name.size());
-            if (entry_ptr->d_type == DT_DIR)
+            if (dir_reader.GetType() == DT_DIR)
             {
-                path_buffer[path_bytes + 0] = '/';
-                path_buffer[path_bytes + 1] = '\0';
-                bool status = ZxFS::DirContentDeleteImp({ path_buffer.get(), path_bytes + 1 }, nPathMaxBytes);
-                if (status == false) { return false; }
-                ::rmdir(path_buffer.get());
+                vcSubDirNames.emplace_back(entry_name);
             }
             else
             {
-                path_buffer[path_bytes] = '\0';
-                ::remove(path_buffer.get());
+                if (ZXFS_STAT_CALL(Unlink, ::unlinkat(dir_fd, entry_name.data(), 0)) == -1 && errno == EISDIR)
+                {
+                    vcSubDirNames.emplace_back(entry_name); // DT_UNKNOWN directory
+                }
             }
         }
 
-        return ::closedir(dir_ptr) != -1 ? true : false;
+        return dir_reader.Close();
+    }
+
+    static auto DirRemoveEmpty(const std::string& msDirPath) -> bool
+    {
+        return ZXFS_STAT_CALL(Unlink, ::rmdir(msDirPath.c_str())) != -1;
+    }
+
+    static auto DirSizeList(const std::string& msDirPath, DirUsage& rfUsage, std::vector<std::string>& vcSubDirNames, DirSizeLinks& rfLinks) -> bool
+    {
+        thread_local Plat::DirReader dir_reader;
+        if (dir_reader.Open(msDirPath.c_str()) == false) { return false; }
+
+        const auto dir_fd{ dir_reader.GetFD() };
+        struct stat st;
+        if (ZXFS_STAT_CALL(Stat, ::fstat(dir_fd, &st)) == -1) { dir_reader.Close(); return false; }
+        rfUsage.ApparentBytes += static_cast<std::uint64_t>(st.st_size);
+        rfUsage.AllocatedBytes += static_cast<std::uint64_t>(st.st_blocks) * 512;
+        rfUsage.DirCount++;
+
+        while (dir_reader.Next())
+        {
+            const auto entry_name{ dir_reader.GetName() };
+            if (dir_reader.GetType() == DT_DIR) { vcSubDirNames.emplace_back(entry_name); continue; }
+
+            if (ZXFS_STAT_CALL(Stat, ::fstatat(dir_fd, entry_name.data(), &st, AT_SYMLINK_NOFOLLOW)) == -1) { continue; } // gone meanwhile
+            if (S_ISDIR(st.st_mode)) { vcSubDirNames.emplace_back(entry_name); continue; } // DT_UNKNOWN directory
+
+            if (st.st_nlink > 1)
+            {
+                std::scoped_lock lock{ rfLinks.Locker };
+                if (rfLinks.Seen.emplace(static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino)).second == false) { continue; }
+            }
+
+            rfUsage.ApparentBytes += static_cast<std::uint64_t>(st.st_size);
+            rfUsage.AllocatedBytes += static_cast<std::uint64_t>(st.st_blocks) * 512;
+            rfUsage.FileCount++;
+        }
+
+        return dir_reader.Close();
     }
 
     auto DirContentDelete(const std::string_view msPath) -> bool
     {
         if (!msPath.ends_with('/')) { return false; }
-        return ZxFS::DirContentDeleteImp(msPath, Plat::PathMaxBytes());
+        return ZxFS::DirContentDeleteImp(msPath);
     }
 
     auto DirDelete(const std::string_view msPath) -> bool
     {
         if (!msPath.ends_with('/')) { return false; }
-        return ::rmdir(msPath.data()) != -1;
+        return ZXFS_STAT_CALL(Unlink, ::rmdir(msPath.data())) != -1;
     }
 
     auto DirDeleteRecursive(const std::string_view msPath) -> bool
     {
         if (!msPath.ends_with('/')) { return false; }
-        ZxFS::DirContentDeleteImp(msPath, Plat::PathMaxBytes());
-        return ::rmdir(msPath.data()) != -1;
+        ZxFS::DirContentDeleteImp(msPath);
+        return ZXFS_STAT_CALL(Unlink, ::rmdir(msPath.data())) != -1;
     }
 
     auto DirMake(const std::string_view msPath) -> bool
     {
         if (!msPath.ends_with('/')) { return false; }
+        ZXFS_STAT_INC(MakeDir);
         return ::mkdir(msPath.data(), 0777) != -1;
     }
 
@@ -455,12 +854,13 @@ namespace ZQF::Zut::ZxFS
     {
         if (!msPath.ends_with('/')) { return false; }
 
-        const auto path_buffer{ std::make_unique_for_overwrite<char[]>(msPath.size() + 1) };
-        std::memcpy(path_buffer.get(), msPath.data(), msPath.size() * sizeof(char));
-        path_buffer[msPath.size()] = {};
+        ZXFS_STAT_PHASE(Make);
+        Scratch::PathBuffer path_buffer{ msPath.size() + 1 };
+        std::memcpy(path_buffer.Data(), msPath.data(), msPath.size() * sizeof(char));
+        path_buffer.Data()[msPath.size()] = {};
 
-        char* cur_path_cstr = path_buffer.get();
-        const char* org_path_cstr = path_buffer.get();
+        char* cur_path_cstr = path_buffer.Data();
+        const char* org_path_cstr = path_buffer.Data();
 
         while (*cur_path_cstr++ != '\0')
         {
@@ -468,8 +868,9 @@ namespace ZQF::Zut::ZxFS
 
             *cur_path_cstr = {};
             {
-                if (::access(org_path_cstr, X_OK) == -1)
+                if (ZXFS_STAT_CALL(Stat, ::access(org_path_cstr, X_OK)) == -1)
                 {
+                    ZXFS_STAT_INC(MakeDir);
                     ::mkdir(org_path_cstr, 0777);
                 }
             }
@@ -480,11 +881,583 @@ namespace ZQF::Zut::ZxFS
         return true;
     }
 
+    // makes vcNodes[nBeg, nEnd) in preorder with mkdirat relative to the parent's fd, only directories with
+    // children are opened (O_PATH). nodes deeper than nMaxDepth are left to later calls.
+    static auto DirMakeSubtree(const std::vector<DirMakeNode>& vcNodes, const std::size_t nBeg, const std::size_t nEnd, const std::size_t nMaxDepth) -> bool
+    {
+        const auto& first_node{ vcNodes[nBeg] };
+        auto base_fd{ AT_FDCWD };
+        if (first_node.NameBeg != 0)
+        {
+            const std::string parent_path{ first_node.Path.substr(0, first_node.NameBeg) };
+            base_fd = ZXFS_STAT_CALL(OpenDir, ::open(parent_path.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC));
+            if (base_fd == -1) { return false; }
+        }
+
+        bool is_all_made{ true };
+        std::string name;
+        std::vector<int> dir_fds; // dir_fds[n] is the open node at depth first_node.Depth + n
+        for (auto index{ nBeg }; index < nEnd; )
+        {
+            const auto& node{ vcNodes[index] };
+            while (dir_fds.size() > node.Depth - first_node.Depth) { ::close(dir_fds.back()); dir_fds.pop_back(); }
+            const auto parent_fd{ dir_fds.empty() ? base_fd : dir_fds.back() };
+            name.assign(node.Path.substr(node.NameBeg, node.Path.size() - node.NameBeg - 1));
+
+            bool is_made{ true };
+            bool is_new{};
+            if (!name.empty())
+            {
+                ZXFS_STAT_INC(MakeDir);
+                is_new = ::mkdirat(parent_fd, name.c_str(), 0777) == 0;
+                is_made = is_new || errno == EEXIST;
+            }
+
+            const auto is_descend{ (node.Depth < nMaxDepth) && (node.SubtreeEnd - index > 1) };
+            if (is_made && is_descend)
+            {
+                const auto dir_fd{ ZXFS_STAT_CALL(OpenDir, ::openat(parent_fd, name.empty() ? "/" : name.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC)) };
+                if (dir_fd == -1) { is_made = false; } else { dir_fds.push_back(dir_fd); }
+            }
+            else if (is_made && !is_new && !name.empty())
+            {
+                struct stat st;
+                is_made = (ZXFS_STAT_CALL(Stat, ::fstatat(parent_fd, name.c_str(), &st, 0)) == 0) && S_ISDIR(st.st_mode); // EEXIST may be a file
+            }
+
+            if (is_made == false) { is_all_made = false; }
+            index = (is_made && is_descend) ? index + 1 : node.SubtreeEnd;
+        }
+
+        for (const auto dir_fd : dir_fds) { ::close(dir_fd); }
+        if (base_fd != AT_FDCWD) { ::close(base_fd); }
+        return is_all_made;
+    }
+
     auto Exist(const std::string_view msPath) -> bool
     {
-        return ::access(msPath.data(), F_OK) != -1;
+        return ZXFS_STAT_CALL(Stat, ::access(msPath.data(), F_OK)) != -1;
+    }
+
+    struct BatchNoSlot {};
+
+    // keeps up to nQueueDepth ops in flight. fnPrep(sqe, index, slot, user_data) fills the sqe for path index,
+    // fnDone(index, slot, res) takes its completion. slot is per-op scratch (e.g. a statx buffer) owned here while the op runs.
+    // paths whose op was never submitted, or completed with -EINVAL (opcode unknown to the kernel), stay BATCH_PENDING.
+    template <typename Slot, typename FnPrep, typename FnDone>
+    static auto BatchQueued(const std::size_t nCount, const std::size_t nQueueDepth, const FnPrep& fnPrep, const FnDone& fnDone) -> void
+    {
+        constexpr std::size_t SLOT_BITS{ 12 };
+        constexpr std::uint64_t SLOT_MASK{ (std::uint64_t{ 1 } << SLOT_BITS) - 1 };
+
+        if (nCount == 0) { return; }
+
+        const auto queue_depth{ std::clamp<std::size_t>(nQueueDepth, 1, std::size_t{ 1 } << SLOT_BITS) };
+        auto slots{ std::make_unique<Slot[]>(queue_depth) }; // declared before the ring, so it outlives any op still in flight
+        std::vector<std::size_t> slot_indices(queue_depth);  // path index of the op using the slot
+        std::vector<std::size_t> free_slots;
+        free_slots.reserve(queue_depth);
+        for (std::size_t slot{ queue_depth }; slot != 0; slot--) { free_slots.push_back(slot - 1); }
+
+        Plat::Uring uring;
+        if (uring.Init(static_cast<unsigned>(queue_depth)) == false) { return; }
+
+        std::size_t next_index{};
+        std::size_t inflight_count{};
+
+        const auto reap = [&]()
+        {
+            std::uint64_t user_data;
+            std::int32_t result;
+            while (uring.PeekCQE(user_data, result))
+            {
+                const auto slot{ static_cast<std::size_t>(user_data & SLOT_MASK) };
+                if (result != -EINVAL) { fnDone(slot_indices[slot], slots[slot], result); }
+                free_slots.push_back(slot);
+                inflight_count--;
+            }
+        };
+
+        while (next_index < nCount || inflight_count != 0)
+        {
+            while (next_index < nCount && !free_slots.empty())
+            {
+                const auto sqe_ptr{ uring.GetSQE() };
+                if (sqe_ptr == nullptr) { break; }
+                const auto slot{ free_slots.back() }; free_slots.pop_back();
+                slot_indices[slot] = next_index;
+                fnPrep(sqe_ptr, next_index, slots[slot], (static_cast<std::uint64_t>(next_index) << SLOT_BITS) | slot);
+                next_index++;
+                inflight_count++;
+            }
+
+            if (uring.Submit(1) == false) { break; }
+            reap();
+        }
+
+        if (inflight_count == 0) { return; }
+
+        // submit failed: ops the kernel never consumed stay BATCH_PENDING for the synchronous fallback, the rest are
+        // waited out, re-running one that already ran (an unlink, a rename) would report it as failed
+        std::uint64_t user_data;
+        while (uring.PopUnsubmitted(user_data)) { free_slots.push_back(static_cast<std::size_t>(user_data & SLOT_MASK)); inflight_count--; }
+        while (inflight_count != 0 && uring.Wait(1)) { reap(); }
+        if (inflight_count == 0) { return; }
+
+        // cannot even wait: the outcome of what is still in flight is unknown, and the kernel may still write into its slots
+        std::vector<bool> is_slot_free(queue_depth);
+        for (const auto slot : free_slots) { is_slot_free[slot] = true; }
+        for (std::size_t slot{}; slot < queue_depth; slot++)
+        {
+            if (is_slot_free[slot] == false) { fnDone(slot_indices[slot], slots[slot], -ECANCELED); }
+        }
+        static_cast<void>(slots.release());
+    }
+
+    static auto FileDeleteQueued(const std::span<const std::string> spPaths, const std::size_t nQueueDepth, std::vector<std::int32_t>& vcResults) -> void
+    {
+        BatchQueued<BatchNoSlot>(spPaths.size(), nQueueDepth,
+            [&](io_uring_sqe* pSQE, const std::size_t nIndex, BatchNoSlot& /* rfSlot */, const std::uint64_t nUserData)
+            {
+                ZXFS_STAT_INC(Unlink);
+                Plat::Uring::PrepUnlinkAt(pSQE, AT_FDCWD, spPaths[nIndex].c_str(), 0, nUserData);
+            },
+            [&](const std::size_t nIndex, BatchNoSlot& /* rfSlot */, const std::int32_t nResult)
+            {
+                if (nResult != -EISDIR) { vcResults[nIndex] = nResult; } // FileDelete also removes empty directories (remove())
+            });
+    }
+
+    static auto FileMoveQueued(const std::span<const std::string> spExistPaths, const std::span<const std::string> spNewPaths, const std::size_t nQueueDepth, std::vector<std::int32_t>& vcResults) -> void
+    {
+        BatchQueued<BatchNoSlot>(spExistPaths.size(), nQueueDepth,
+            [&](io_uring_sqe* pSQE, const std::size_t nIndex, BatchNoSlot& /* rfSlot */, const std::uint64_t nUserData)
+            {
+                ZXFS_STAT_INC(Rename);
+                Plat::Uring::PrepRenameAt(pSQE, AT_FDCWD, spExistPaths[nIndex].c_str(), AT_FDCWD, spNewPaths[nIndex].c_str(), 0, nUserData);
+            },
+            [&](const std::size_t nIndex, BatchNoSlot& /* rfSlot */, const std::int32_t nResult)
+            {
+                vcResults[nIndex] = nResult;
+            });
+    }
+
+    // follows symlinks like stat(), pSizes == nullptr only checks for existence
+    static auto FileStatQueued(const std::span<const std::string> spPaths, const std::size_t nQueueDepth, std::vector<std::int32_t>& vcResults, std::vector<std::optional<std::uint64_t>>* pSizes) -> void
+    {
+        BatchQueued<struct statx>(spPaths.size(), nQueueDepth,
+            [&](io_uring_sqe* pSQE, const std::size_t nIndex, struct statx& rfSlot, const std::uint64_t nUserData)
+            {
+                ZXFS_STAT_INC(Stat);
+                Plat::Uring::PrepStatx(pSQE, AT_FDCWD, spPaths[nIndex].c_str(), 0, pSizes != nullptr ? STATX_SIZE : STATX_TYPE, &rfSlot, nUserData);
+            },
+            [&](const std::size_t nIndex, struct statx& rfSlot, const std::int32_t nResult)
+            {
+                vcResults[nIndex] = nResult;
+                if (nResult == 0 && pSizes != nullptr) { (*pSizes)[nIndex] = rfSlot.stx_size; }
+            });
     }
 } // namespace ZQF::Zut::ZxFS
 #endif
 
+namespace ZQF::Zut::ZxFS
+{
+    auto FileCopy(const std::string_view msExistPath, const std::string_view msNewPath, bool isFailIfExists) -> bool
+    {
+        return ZxFS::FileCopy(msExistPath, msNewPath, isFailIfExists, FileCopyFlag::Default);
+    }
+
+    // runs fnOp(index) for every path still BATCH_PENDING, chunks of them go to a pool once there are enough
+    template <typename FnOp>
+    static auto BatchRunPending(std::vector<std::int32_t>& vcResults, const FnOp& fnOp) -> void
+    {
+        constexpr std::size_t CHUNK_SIZE{ 256 };
+
+        std::vector<std::size_t> pending_indices;
+        for (std::size_t index{}; index < vcResults.size(); index++)
+        {
+            if (vcResults[index] == BATCH_PENDING) { pending_indices.push_back(index); }
+        }
+
+        const auto run_chunk = [&](const std::size_t nBeg, const std::size_t nEnd)
+        {
+            for (auto pos{ nBeg }; pos < nEnd; pos++) { vcResults[pending_indices[pos]] = fnOp(pending_indices[pos]); }
+        };
+
+        if (pending_indices.size() <= CHUNK_SIZE) { run_chunk(0, pending_indices.size()); return; }
+
+        Pool pool{ std::min(Pool::ThreadCount(0), (pending_indices.size() + CHUNK_SIZE - 1) / CHUNK_SIZE) };
+        for (std::size_t beg{}; beg < pending_indices.size(); beg += CHUNK_SIZE)
+        {
+            pool.Submit([&run_chunk, beg, end = std::min(beg + CHUNK_SIZE, pending_indices.size())] { run_chunk(beg, end); });
+        }
+        pool.Wait();
+    }
+
+    static auto BatchSucceeded(const std::vector<std::int32_t>& vcResults) -> std::vector<bool>
+    {
+        std::vector<bool> succeeded(vcResults.size());
+        for (std::size_t index{}; index < vcResults.size(); index++) { succeeded[index] = vcResults[index] >= 0; }
+        return succeeded;
+    }
+
+    auto FileDelete(const std::span<const std::string> spPaths, const std::size_t nQueueDepth) -> std::vector<bool>
+    {
+        ZXFS_STAT_PHASE(Delete);
+        std::vector<std::int32_t> results(spPaths.size(), BATCH_PENDING);
+        ZxFS::FileDeleteQueued(spPaths, nQueueDepth, results);
+        BatchRunPending(results, [&](const std::size_t nIndex) { return ZxFS::FileDelete(spPaths[nIndex]) ? 0 : -1; });
+        return BatchSucceeded(results);
+    }
+
+    auto FileMove(const std::span<const std::string> spExistPaths, const std::span<const std::string> spNewPaths, const std::size_t nQueueDepth) -> std::vector<bool>
+    {
+        ZXFS_STAT_PHASE(Move);
+        const auto pair_count{ std::min(spExistPaths.size(), spNewPaths.size()) };
+        std::vector<std::int32_t> results(spExistPaths.size(), -1);
+        std::fill_n(results.begin(), pair_count, BATCH_PENDING);
+        ZxFS::FileMoveQueued(spExistPaths.first(pair_count), spNewPaths.first(pair_count), nQueueDepth, results);
+        BatchRunPending(results, [&](const std::size_t nIndex) { return ZxFS::FileMove(spExistPaths[nIndex], spNewPaths[nIndex]) ? 0 : -1; });
+        return BatchSucceeded(results);
+    }
+
+    auto FileSize(const std::span<const std::string> spPaths, const std::size_t nQueueDepth) -> std::vector<std::optional<std::uint64_t>>
+    {
+        ZXFS_STAT_PHASE(Size);
+        std::vector<std::optional<std::uint64_t>> sizes(spPaths.size());
+        std::vector<std::int32_t> results(spPaths.size(), BATCH_PENDING);
+        ZxFS::FileStatQueued(spPaths, nQueueDepth, results, &sizes);
+        BatchRunPending(results, [&](const std::size_t nIndex) { sizes[nIndex] = ZxFS::FileSize(spPaths[nIndex]); return sizes[nIndex].has_value() ? 0 : -1; });
+        return sizes;
+    }
+
+    auto Exist(const std::span<const std::string> spPaths, const std::size_t nQueueDepth) -> std::vector<bool>
+    {
+        ZXFS_STAT_PHASE(Size);
+        std::vector<std::int32_t> results(spPaths.size(), BATCH_PENDING);
+        ZxFS::FileStatQueued(spPaths, nQueueDepth, results, nullptr);
+        BatchRunPending(results, [&](const std::size_t nIndex) { return ZxFS::Exist(spPaths[nIndex]) ? 0 : -1; });
+        return BatchSucceeded(results);
+    }
+
+    struct DeleteDirNode
+    {
+        std::string DirPath;
+        DeleteDirNode* pParent{};
+        std::atomic<std::size_t> PendingCount{ 1 }; // own listing + unfinished sub directories
+    };
+
+    static auto DirContentDeleteParallel(const std::string_view msPath, const bool isRemoveBaseDir, const std::size_t nThreads) -> bool
+    {
+        ZXFS_STAT_PHASE(Delete);
+        // a directory is removed by whichever worker finishes its last pending child, then the parent is notified.
+        std::atomic<bool> is_failed{ false };
+        std::atomic<bool> is_base_removed{ false };
+        Pool pool{ nThreads };
+
+        const std::function<void(DeleteDirNode*)> finish_node = [&](DeleteDirNode* pNode)
+        {
+            while (pNode != nullptr && pNode->PendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                const auto parent_ptr{ pNode->pParent };
+                if (parent_ptr != nullptr)
+                {
+                    ZxFS::DirRemoveEmpty(pNode->DirPath);
+                }
+                else if (isRemoveBaseDir)
+                {
+                    is_base_removed.store(ZxFS::DirRemoveEmpty(pNode->DirPath));
+                }
+                delete pNode;
+                pNode = parent_ptr;
+            }
+        };
+
+        const std::function<void(DeleteDirNode*)> clear_node = [&](DeleteDirNode* pNode)
+        {
+            std::vector<std::string> sub_dir_names;
+            if (ZxFS::DirClearFiles(pNode->DirPath, sub_dir_names) == false)
+            {
+                is_failed.store(true);
+                sub_dir_names.clear();
+            }
+
+            pNode->PendingCount.fetch_add(sub_dir_names.size(), std::memory_order_relaxed);
+            for (auto& sub_dir_name : sub_dir_names)
+            {
+                const auto sub_node_ptr{ new DeleteDirNode{ std::string{ pNode->DirPath }.append(sub_dir_name).append(1, '/'), pNode } };
+                pool.Submit([&clear_node, sub_node_ptr] { clear_node(sub_node_ptr); });
+            }
+
+            finish_node(pNode);
+        };
+
+        const auto base_node_ptr{ new DeleteDirNode{ std::string{ msPath }, nullptr } };
+        pool.Submit([&clear_node, base_node_ptr] { clear_node(base_node_ptr); });
+        pool.Wait();
+
+        if (is_failed.load()) { return false; }
+        return isRemoveBaseDir ? is_base_removed.load() : true;
+    }
+
+    auto DirContentDelete(const std::string_view msPath, const std::size_t nThreads) -> bool
+    {
+        if (!msPath.ends_with('/')) { return false; }
+        return ZxFS::DirContentDeleteParallel(msPath, false, nThreads);
+    }
+
+    auto DirDeleteRecursive(const std::string_view msPath, const std::size_t nThreads) -> bool
+    {
+        if (!msPath.ends_with('/')) { return false; }
+        return ZxFS::DirContentDeleteParallel(msPath, true, nThreads);
+    }
+
+    static auto DirCopyParallel(const std::string_view msExistDir, const std::string_view msNewDir, const bool isFailIfExists, const std::size_t nThreads, std::vector<std::string>& vcFailedPaths) -> bool
+    {
+        // a directory task creates its target, queues its sub directories before its files so other workers can
+        // start on them, then hands the files out in batches. targets of a directory exist before any child task runs.
+        constexpr std::size_t FILE_BATCH_SIZE{ 64 };
+
+        std::mutex failed_locker;
+        std::atomic<bool> is_failed{ false };
+        Pool pool{ nThreads };
+
+        const auto add_failed = [&](std::string msPath)
+        {
+            is_failed.store(true, std::memory_order_relaxed);
+            std::scoped_lock lock{ failed_locker };
+            vcFailedPaths.emplace_back(std::move(msPath));
+        };
+
+        const auto copy_files = [&](const std::string& msExistPath, const std::string& msNewPath, const std::vector<std::string>& vcNames)
+        {
+            for (const auto& name : vcNames)
+            {
+                const auto exist_file_path{ std::string{ msExistPath }.append(name) };
+                if (ZxFS::FileCopy(exist_file_path, std::string{ msNewPath }.append(name), isFailIfExists) == false) { add_failed(exist_file_path); }
+            }
+        };
+
+        const std::function<void(std::string, std::string)> copy_dir = [&](std::string msExistPath, std::string msNewPath)
+        {
+            if (ZxFS::DirMake(msNewPath) == false && ZxFS::Exist(msNewPath) == false) { add_failed(std::move(msExistPath)); return; }
+
+            std::vector<std::string> file_names;
+            try
+            {
+                for (ZxFS::Walker walk{ msExistPath }; walk.Next(); )
+                {
+                    if (walk.GetEntry().IsDir())
+                    {
+                        pool.Submit([&copy_dir, exist_path = std::string{ walk.GetPath() }, new_path = std::string{ msNewPath }.append(walk.GetName())]() mutable { copy_dir(std::move(exist_path), std::move(new_path)); });
+                    }
+                    else if (walk.GetEntry().IsFile())
+                    {
+                        file_names.emplace_back(walk.GetName());
+                        if (file_names.size() == FILE_BATCH_SIZE)
+                        {
+                            pool.Submit([&copy_files, msExistPath, msNewPath, names = std::move(file_names)] { copy_files(msExistPath, msNewPath, names); });
+                            file_names.clear();
+                        }
+                    }
+                    else
+                    {
+                        add_failed(std::string{ walk.GetPath() }); // symlinks, fifos, sockets, devices are not copied
+                    }
+                }
+            }
+            catch (const std::exception&)
+            {
+                add_failed(msExistPath);
+            }
+
+            copy_files(msExistPath, msNewPath, file_names);
+        };
+
+        pool.Submit([&copy_dir, exist_dir = std::string{ msExistDir }, new_dir = std::string{ msNewDir }]() mutable { copy_dir(std::move(exist_dir), std::move(new_dir)); });
+        pool.Wait();
+
+        return is_failed.load() == false;
+    }
+
+    static auto DirSizeParallel(const std::string_view msPath, const std::size_t nThreads, std::vector<std::pair<std::string, DirUsage>>* pDirUsages) -> std::optional<DirUsage>
+    {
+        ZXFS_STAT_PHASE(Size);
+        // every directory task lists its own entries (fstatat relative to its fd) and queues its sub directories,
+        // per directory usages are folded into subtree totals afterwards, deepest first.
+        std::mutex usage_locker;
+        std::vector<std::pair<std::string, DirUsage>> dir_usages;
+        std::atomic<bool> is_base_failed{ false };
+        DirSizeLinks links;
+        Pool pool{ nThreads };
+
+        const std::function<void(std::string)> size_dir = [&](std::string msDirName)
+        {
+            DirUsage usage;
+            std::vector<std::string> sub_dir_names;
+            if (ZxFS::DirSizeList(std::string{ msPath }.append(msDirName), usage, sub_dir_names, links) == false)
+            {
+                if (msDirName.empty()) { is_base_failed.store(true); return; }
+                std::scoped_lock lock{ usage_locker };
+                dir_usages.emplace_back(std::move(msDirName), DirUsage{ .FailedDirCount = 1 }); // rolls up, so the totals do not undercount silently
+                return;
+            }
+
+            for (const auto& sub_dir_name : sub_dir_names)
+            {
+                pool.Submit([&size_dir, sub_dir = std::string{ msDirName }.append(sub_dir_name).append(1, '/')]() mutable { size_dir(std::move(sub_dir)); });
+            }
+
+            std::scoped_lock lock{ usage_locker };
+            dir_usages.emplace_back(std::move(msDirName), usage);
+        };
+
+        pool.Submit([&size_dir] { size_dir(std::string{}); });
+        pool.Wait();
+
+        if (is_base_failed.load()) { return std::nullopt; }
+
+        std::ranges::sort(dir_usages, [](const auto& rfA, const auto& rfB) { return rfA.first > rfB.first; }); // children sort before their parent ("a/b/" > "a/"), the roll-up below folds deepest first
+        if (pDirUsages == nullptr)
+        {
+            DirUsage total;
+            for (const auto& [dir_name, usage] : dir_usages)
+            {
+                total.ApparentBytes += usage.ApparentBytes;
+                total.AllocatedBytes += usage.AllocatedBytes;
+                total.FileCount += usage.FileCount;
+                total.DirCount += usage.DirCount;
+                total.FailedDirCount += usage.FailedDirCount;
+            }
+            return total;
+        }
+
+        std::unordered_map<std::string_view, std::size_t> dir_index;
+        for (std::size_t index{}; index < dir_usages.size(); index++) { dir_index.emplace(dir_usages[index].first, index); }
+
+        for (auto& [dir_name, usage] : dir_usages)
+        {
+            if (dir_name.empty()) { continue; }
+            const auto parent_name{ std::string_view{ dir_name }.substr(0, std::string_view{ dir_name }.substr(0, dir_name.size() - 1).rfind('/') + 1) };
+            const auto parent_ite{ dir_index.find(parent_name) };
+            if (parent_ite == dir_index.end()) { continue; }
+            auto& parent_usage{ dir_usages[parent_ite->second].second };
+            parent_usage.ApparentBytes += usage.ApparentBytes;
+            parent_usage.AllocatedBytes += usage.AllocatedBytes;
+            parent_usage.FileCount += usage.FileCount;
+            parent_usage.DirCount += usage.DirCount;
+            parent_usage.FailedDirCount += usage.FailedDirCount;
+        }
+
+        const auto total{ dir_usages.back().second };
+        std::ranges::move(dir_usages, std::back_inserter(*pDirUsages));
+        return total;
+    }
+
+    auto DirSize(const std::string_view msPath, const std::size_t nThreads) -> std::optional<DirUsage>
+    {
+        if (!msPath.ends_with('/')) { return std::nullopt; }
+        return ZxFS::DirSizeParallel(msPath, nThreads, nullptr);
+    }
+
+    auto DirSize(const std::string_view msPath, const std::size_t nThreads, std::vector<std::pair<std::string, DirUsage>>& vcDirUsages) -> std::optional<DirUsage>
+    {
+        if (!msPath.ends_with('/')) { return std::nullopt; }
+        return ZxFS::DirSizeParallel(msPath, nThreads, &vcDirUsages);
+    }
+
+    // prefix trie of spPaths in preorder, a directory shared by many paths becomes one node.
+    // sorting puts every path below a directory next to each other, so only the current branch is compared.
+    static auto DirMakeTrie(const std::span<const std::string> spPaths, std::vector<DirMakeNode>& vcNodes) -> bool
+    {
+        std::vector<std::string_view> paths{ spPaths.begin(), spPaths.end() };
+        std::ranges::sort(paths);
+        paths.erase(std::ranges::unique(paths).begin(), paths.end());
+
+        const auto node_name = [&vcNodes](const std::size_t nIndex) { const auto& node{ vcNodes[nIndex] }; return node.Path.substr(node.NameBeg, node.Path.size() - node.NameBeg - 1); };
+        const auto close_branch = [&vcNodes](std::vector<std::size_t>& vcBranch, const std::size_t nDepth)
+        {
+            while (vcBranch.size() > nDepth) { vcNodes[vcBranch.back()].SubtreeEnd = vcNodes.size(); vcBranch.pop_back(); }
+        };
+
+        std::vector<std::size_t> branch; // node index per depth of the previous path
+        for (const auto path : paths)
+        {
+            if (!path.ends_with('/')) { return false; }
+
+            std::size_t depth{};
+            for (std::size_t name_beg{}, slash_pos{}; (slash_pos = path.find('/', name_beg)) != std::string_view::npos; name_beg = slash_pos + 1)
+            {
+                if ((slash_pos == name_beg) && (name_beg != 0)) { continue; } // "a//b/"
+
+                const auto name{ path.substr(name_beg, slash_pos - name_beg) };
+                if (depth < branch.size())
+                {
+                    if (node_name(branch[depth]) == name) { depth++; continue; }
+                    close_branch(branch, depth);
+                }
+
+                vcNodes.emplace_back(DirMakeNode{ .Path = path.substr(0, slash_pos + 1), .NameBeg = name_beg, .Depth = depth });
+                branch.push_back(vcNodes.size() - 1);
+                depth++;
+            }
+        }
+        close_branch(branch, 0);
 
+        return true;
+    }
+
+    auto DirMakeRecursive(const std::span<const std::string> spPaths, const std::size_t nThreads) -> bool
+    {
+        ZXFS_STAT_PHASE(Make);
+
+        std::vector<DirMakeNode> nodes;
+        if (ZxFS::DirMakeTrie(spPaths, nodes) == false) { return false; }
+        if (nodes.empty()) { return true; }
+
+        const auto thread_count{ Pool::ThreadCount(nThreads) };
+        if ((thread_count < 2) || (nodes.size() <= 256)) { return ZxFS::DirMakeSubtree(nodes, 0, nodes.size(), std::numeric_limits<std::size_t>::max()); }
+
+        // the levels above split_depth are made here, each subtree rooted at split_depth goes to a worker
+        std::vector<std::size_t> depth_counts;
+        for (const auto& node : nodes)
+        {
+            if (node.Depth >= depth_counts.size()) { depth_counts.resize(node.Depth + 1); }
+            depth_counts[node.Depth]++;
+        }
+        auto split_depth{ static_cast<std::size_t>(std::ranges::max_element(depth_counts) - depth_counts.begin()) };
+        for (std::size_t depth{}; depth < depth_counts.size(); depth++)
+        {
+            if (depth_counts[depth] >= thread_count * 4) { split_depth = depth; break; }
+        }
+
+        std::atomic<bool> is_all_made{ true };
+        if ((split_depth != 0) && (ZxFS::DirMakeSubtree(nodes, 0, nodes.size(), split_depth - 1) == false)) { is_all_made = false; }
+
+        Pool pool{ std::min(thread_count, depth_counts[split_depth]) };
+        for (std::size_t index{}; index < nodes.size(); index++)
+        {
+            if (nodes[index].Depth != split_depth) { continue; }
+            pool.Submit([&nodes, &is_all_made, index]
+                {
+                    if (ZxFS::DirMakeSubtree(nodes, index, nodes[index].SubtreeEnd, std::numeric_limits<std::size_t>::max()) == false) { is_all_made.store(false, std::memory_order_relaxed); }
+                });
+        }
+        pool.Wait();
+
+        return is_all_made.load(std::memory_order_relaxed);
+    }
+
+    auto DirCopyRecursive(const std::string_view msExistDir, const std::string_view msNewDir, const bool isFailIfExists, const std::size_t nThreads) -> bool
+    {
+        std::vector<std::string> failed_paths;
+        return ZxFS::DirCopyRecursive(msExistDir, msNewDir, isFailIfExists, nThreads, failed_paths);
+    }
+
+    auto DirCopyRecursive(const std::string_view msExistDir, const std::string_view msNewDir, const bool isFailIfExists, const std::size_t nThreads, std::vector<std::string>& vcFailedPaths) -> bool
+    {
+        if (!msExistDir.ends_with('/') || !msNewDir.ends_with('/')) { return false; }
+        if (ZxFS::DirMakeRecursive(msNewDir) == false && ZxFS::Exist(msNewDir) == false) { return false; }
+        return ZxFS::DirCopyParallel(msExistDir, msNewDir, isFailIfExists, nThreads, vcFailedPaths);
+    }
+} // namespace ZQF::Zut::ZxFS
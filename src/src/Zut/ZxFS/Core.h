@@ -1,31 +1,112 @@
 #pragma once
+#include <span>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <memory>
 #include <optional>
 #include <string_view>
+#include <Zut/ZxFS/PathList.h>
 
 
 namespace ZQF::Zut::ZxFS
 {
+    // FileCopy strategies, tried in this order, the plain copy is the final fallback
+    struct FileCopyFlag
+    {
+        static constexpr std::uint32_t None{ 0x0 };
+        static constexpr std::uint32_t Reflink{ 0x1 };     // share extents (FICLONE) on copy-on-write filesystems
+        static constexpr std::uint32_t Sparse{ 0x2 };      // copy data ranges only (SEEK_DATA / SEEK_HOLE), holes stay holes
+        static constexpr std::uint32_t Preallocate{ 0x4 }; // fallocate each data range before writing it
+        static constexpr std::uint32_t Default{ Reflink | Sparse | Preallocate };
+    };
+
+    // totals of DirSize, AllocatedBytes counts the blocks actually held on disk (holes and hardlink copies excluded)
+    struct DirUsage
+    {
+        std::uint64_t ApparentBytes{};
+        std::uint64_t AllocatedBytes{};
+        std::uint64_t FileCount{};
+        std::uint64_t DirCount{};
+        std::uint64_t FailedDirCount{}; // directories that could not be listed, their subtrees are missing from the other totals
+    };
+
     auto SelfDir() -> std::pair<std::string_view, std::unique_ptr<char[]>>;
     auto SelfPath() -> std::pair<std::string_view, std::unique_ptr<char[]>>;
 
-    auto FileName(const std::string_view msPath) -> std::string_view;
-    auto FileNameStem(const std::string_view msPath) -> std::string_view;
-    auto FileSuffix(const std::string_view msPath) -> std::string_view;
-    auto FileSuffixDel(const std::string_view msPath) -> std::string_view;
+    constexpr auto FileName(const std::string_view msPath) -> std::string_view
+    {
+        const auto pos = msPath.rfind('/');
+        return pos != std::string_view::npos ? msPath.substr(pos + 1) : msPath;
+    }
+
+    constexpr auto FileSuffix(const std::string_view msPath) -> std::string_view
+    {
+        const auto pos = msPath.find_last_of("/.");
+        return (pos != std::string_view::npos && msPath[pos] == '.') ? msPath.substr(pos) : std::string_view{ "", 0 };
+    }
+
+    constexpr auto FileSuffixDel(const std::string_view msPath) -> std::string_view
+    {
+        const auto pos = msPath.find_last_of("/.");
+        return (pos != std::string_view::npos && msPath[pos] == '.') ? msPath.substr(0, pos) : msPath;
+    }
+
+    constexpr auto FileNameStem(const std::string_view msPath) -> std::string_view
+    {
+        return ZxFS::FileSuffixDel(ZxFS::FileName(msPath));
+    }
+
+    // component offsets of one path, the batch form of the functions above:
+    // FileName = [NameBeg, Bytes), FileSuffix = [SuffixBeg, Bytes), FileSuffixDel = [0, SuffixBeg), stem = [NameBeg, SuffixBeg)
+    struct PathComponents
+    {
+        std::size_t NameBeg{};
+        std::size_t SuffixBeg{}; // == Bytes when there is no suffix
+        std::size_t Bytes{};
+    };
+
+    // appends one PathComponents per path, last '/' / '.' searched 16 bytes at a time (SSE2)
+    auto PathSplit(const PathList& rfPaths, std::vector<PathComponents>& vcComponents) -> void;
+    auto PathSplit(const std::span<const std::string> spPaths, std::vector<PathComponents>& vcComponents) -> void;
+    auto PathSplit(const std::span<const std::string_view> spPaths, std::vector<PathComponents>& vcComponents) -> void;
 
     auto FileDelete(const std::string_view msPath) -> bool;
     auto FileMove(const std::string_view msExistPath, const std::string_view msNewPath) -> bool;
-    auto FileCopy(const std::string_view msExistPath, const std::string_view msNewPath, bool isFailIfExists) -> bool;
+    auto FileCopy(const std::string_view msExistPath, const std::string_view msNewPath, bool isFailIfExists) -> bool; // FileCopyFlag::Default
+    auto FileCopy(const std::string_view msExistPath, const std::string_view msNewPath, bool isFailIfExists, const std::uint32_t nFlags) -> bool;
     auto FileSize(const std::string_view msPath) -> std::optional<std::uint64_t>;
 
     auto DirContentDelete(const std::string_view msPath) -> bool;
     auto DirDelete(const std::string_view msPath) -> bool;
     auto DirDeleteRecursive(const std::string_view msPath) -> bool;
+    auto DirContentDelete(const std::string_view msPath, const std::size_t nThreads) -> bool; // nThreads == 0 -> std::thread::hardware_concurrency()
+    auto DirDeleteRecursive(const std::string_view msPath, const std::size_t nThreads) -> bool;
     auto DirMake(const std::string_view msPath) -> bool;
     auto DirMakeRecursive(const std::string_view msPath) -> bool;
+    // mkdir -p for many paths (each ending with '/'): directories shared by several paths are made or checked once,
+    // independent subtrees on nThreads workers. false if a path has no trailing '/' or any directory could not be made.
+    auto DirMakeRecursive(const std::span<const std::string> spPaths, const std::size_t nThreads) -> bool;
+    // copies the tree under msExistDir into msNewDir (created if missing), directories first, files on nThreads workers.
+    // a failing file or directory does not stop the copy, its source path is appended to vcFailedPaths.
+    // entries that are neither (symlinks, fifos, sockets, devices) are not copied and are reported the same way.
+    auto DirCopyRecursive(const std::string_view msExistDir, const std::string_view msNewDir, const bool isFailIfExists, const std::size_t nThreads) -> bool;
+    auto DirCopyRecursive(const std::string_view msExistDir, const std::string_view msNewDir, const bool isFailIfExists, const std::size_t nThreads, std::vector<std::string>& vcFailedPaths) -> bool;
+
+    // du-style size of everything under msPath (directories included), walked on nThreads workers.
+    // a file with several hardlinks inside the tree is counted once. vcDirUsages receives the subtree total
+    // of every directory keyed by its path relative to msPath ("" is msPath itself). std::nullopt if msPath itself
+    // cannot be listed, a sub directory that cannot be listed is reported through FailedDirCount instead.
+    auto DirSize(const std::string_view msPath, const std::size_t nThreads) -> std::optional<DirUsage>;
+    auto DirSize(const std::string_view msPath, const std::size_t nThreads, std::vector<std::pair<std::string, DirUsage>>& vcDirUsages) -> std::optional<DirUsage>;
 
     auto Exist(const std::string_view msPath) -> bool;
+
+    // batch forms, result[i] belongs to path i. on linux up to nQueueDepth unlinkat / renameat / statx are kept in flight
+    // on io_uring, without it (or for what it rejects) the single-path functions above run on a worker pool.
+    // FileMove pairs spExistPaths[i] with spNewPaths[i], an exist path without a new path reports false.
+    auto FileDelete(const std::span<const std::string> spPaths, const std::size_t nQueueDepth) -> std::vector<bool>;
+    auto FileMove(const std::span<const std::string> spExistPaths, const std::span<const std::string> spNewPaths, const std::size_t nQueueDepth) -> std::vector<bool>;
+    auto FileSize(const std::span<const std::string> spPaths, const std::size_t nQueueDepth) -> std::vector<std::optional<std::uint64_t>>;
+    auto Exist(const std::span<const std::string> spPaths, const std::size_t nQueueDepth) -> std::vector<bool>;
 } // namespace ZQF::Zut::ZxFS
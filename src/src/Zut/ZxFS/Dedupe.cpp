@@ -0,0 +1,338 @@
+#include "Dedupe.h"
+#include "MappedFile.h"
+#include "Pool.h"
+#include "Probe.h"
+#include <bit>
+#include <array>
+#include <tuple>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    using DedupeHash = std::array<std::uint64_t, 2>;
+
+    // one regular file passed to Dedupe::Run
+    struct DedupeFile
+    {
+        std::string_view Path;
+        std::uint64_t Bytes{};
+        std::uint64_t Dev{};
+        std::uint64_t Ino{};
+        bool IsValid{};
+    };
+
+    // one distinct file (hardlinks collapsed), only it is read. its paths are Files[FileBeg, FileEnd) of the sorted order
+    struct DedupeInode
+    {
+        std::size_t FileBeg{};
+        std::size_t FileEnd{};
+        std::uint64_t Bytes{};
+        DedupeHash PartialHash{};
+        bool IsValid{ true };
+    };
+
+    // inodes of one bucket with byte-identical content, Reference is the first one and stays mapped for the compares
+    struct DedupeClass
+    {
+        DedupeHash Hash{};
+        MappedFile Reference;
+        std::vector<std::size_t> Inodes;
+    };
+} // namespace ZQF::Zut::ZxFS
+
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include "Plat.h"
+
+
+namespace ZQF::Zut::ZxFS
+{
+    static auto DedupeStat(const std::string_view msPath, DedupeFile& rfFile) -> bool
+    {
+        ZXFS_STAT_INC(OpenFile);
+        const auto hfile = ::CreateFileW(Plat::PathUTF8ToWide(msPath).second.get(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_OPEN_REPARSE_POINT, nullptr);
+        if (hfile == INVALID_HANDLE_VALUE) { return false; }
+
+        BY_HANDLE_FILE_INFORMATION info;
+        const auto status{ ZXFS_STAT_CALL(Stat, ::GetFileInformationByHandle(hfile, &info)) };
+        ::CloseHandle(hfile);
+        if ((status == FALSE) || (info.dwFileAttributes & (FILE_ATTRIBUTE_DIRECTORY | FILE_ATTRIBUTE_REPARSE_POINT))) { return false; } // a link is not followed, its target is a candidate of its own
+
+        rfFile.Bytes = (static_cast<std::uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+        rfFile.Dev = info.dwVolumeSerialNumber;
+        rfFile.Ino = (static_cast<std::uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+        return true;
+    }
+
+    // nBytes from nOffset plus nTailBytes from nTailOffset, false on a short read
+    static auto DedupeRead(const std::string_view msPath, const std::uint64_t nOffset, std::byte* pBuffer, const std::size_t nBytes, const std::uint64_t nTailOffset, std::byte* pTailBuffer, const std::size_t nTailBytes) -> bool
+    {
+        ZXFS_STAT_INC(OpenFile);
+        const auto hfile = ::CreateFileW(Plat::PathUTF8ToWide(msPath).second.get(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (hfile == INVALID_HANDLE_VALUE) { return false; }
+
+        const auto read_at = [hfile](const std::uint64_t nReadOffset, std::byte* pReadBuffer, const std::size_t nReadBytes) -> bool
+        {
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(nReadOffset);
+            overlapped.OffsetHigh = static_cast<DWORD>(nReadOffset >> 32);
+            DWORD read_bytes{};
+            return (::ReadFile(hfile, pReadBuffer, static_cast<DWORD>(nReadBytes), &read_bytes, &overlapped) != FALSE) && (read_bytes == nReadBytes);
+        };
+
+        const auto status{ read_at(nOffset, pBuffer, nBytes) && ((nTailBytes == 0) || read_at(nTailOffset, pTailBuffer, nTailBytes)) };
+        ::CloseHandle(hfile);
+        return status;
+    }
+} // namespace ZQF::Zut::ZxFS
+#elif __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    static auto DedupeStat(const std::string_view msPath, DedupeFile& rfFile) -> bool
+    {
+        struct stat st; // lstat, a symlink is not followed, its target is a candidate of its own
+        if ((ZXFS_STAT_CALL(Stat, ::lstat(msPath.data(), &st)) == -1) || !S_ISREG(st.st_mode)) { return false; }
+
+        rfFile.Bytes = static_cast<std::uint64_t>(st.st_size);
+        rfFile.Dev = static_cast<std::uint64_t>(st.st_dev);
+        rfFile.Ino = static_cast<std::uint64_t>(st.st_ino);
+        return true;
+    }
+
+    // nBytes from nOffset plus nTailBytes from nTailOffset, false on a short read
+    static auto DedupeRead(const std::string_view msPath, const std::uint64_t nOffset, std::byte* pBuffer, const std::size_t nBytes, const std::uint64_t nTailOffset, std::byte* pTailBuffer, const std::size_t nTailBytes) -> bool
+    {
+        ZXFS_STAT_INC(OpenFile);
+        const auto fd{ ::open(msPath.data(), O_RDONLY | O_CLOEXEC) };
+        if (fd == -1) { return false; }
+
+        const auto read_at = [fd](const std::uint64_t nReadOffset, std::byte* pReadBuffer, const std::size_t nReadBytes) -> bool
+        {
+            for (std::size_t read_total{}; read_total < nReadBytes; )
+            {
+                const auto read_bytes{ ::pread(fd, pReadBuffer + read_total, nReadBytes - read_total, static_cast<off_t>(nReadOffset + read_total)) };
+                if (read_bytes == -1) { if (errno == EINTR) { continue; } return false; }
+                if (read_bytes == 0) { return false; } // shrank since the stat
+                read_total += static_cast<std::size_t>(read_bytes);
+            }
+            return true;
+        };
+
+        const auto status{ read_at(nOffset, pBuffer, nBytes) && ((nTailBytes == 0) || read_at(nTailOffset, pTailBuffer, nTailBytes)) };
+        ::close(fd);
+        return status;
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // 128-bit non-cryptographic content hash, four xxh64 style lanes over 32 byte stripes. it only sorts candidates, a match is confirmed byte for byte
+    static auto DedupeHashBytes(const std::span<const std::byte> spData) -> DedupeHash
+    {
+        constexpr std::uint64_t P1{ 0x9E3779B185EBCA87 };
+        constexpr std::uint64_t P2{ 0xC2B2AE3D27D4EB4F };
+        constexpr std::uint64_t P3{ 0x165667B19E3779F9 };
+        constexpr std::uint64_t P4{ 0x85EBCA77C2B2AE63 };
+        constexpr std::uint64_t P5{ 0x27D4EB2F165667C5 };
+
+        const auto round = [](const std::uint64_t nAcc, const std::uint64_t nInput) { return std::rotl(nAcc + nInput * P2, 31) * P1; };
+        const auto load = [](const std::byte* pData) { std::uint64_t value; std::memcpy(&value, pData, sizeof(value)); return value; };
+        const auto avalanche = [](std::uint64_t nHash) { nHash ^= nHash >> 33; nHash *= P2; nHash ^= nHash >> 29; nHash *= P3; nHash ^= nHash >> 32; return nHash; };
+
+        std::array<std::uint64_t, 4> lanes{ P1 + P2, P2, 0, std::uint64_t{} - P1 };
+        const auto data_ptr{ spData.data() };
+        std::size_t pos{};
+        for (; pos + 32 <= spData.size(); pos += 32)
+        {
+            lanes[0] = round(lanes[0], load(data_ptr + pos));
+            lanes[1] = round(lanes[1], load(data_ptr + pos + 8));
+            lanes[2] = round(lanes[2], load(data_ptr + pos + 16));
+            lanes[3] = round(lanes[3], load(data_ptr + pos + 24));
+        }
+
+        std::uint64_t tail{ P5 + spData.size() };
+        for (; pos + 8 <= spData.size(); pos += 8) { tail = std::rotl(tail ^ round(0, load(data_ptr + pos)), 27) * P1 + P4; }
+        for (; pos < spData.size(); pos++) { tail = std::rotl(tail ^ (static_cast<std::uint64_t>(data_ptr[pos]) * P5), 11) * P1; }
+
+        const auto hash_lo{ std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18) + tail };
+        const auto hash_hi{ (lanes[0] ^ std::rotl(lanes[1], 29) ^ std::rotl(lanes[2], 41) ^ std::rotl(lanes[3], 53)) + tail * P3 };
+        return { avalanche(hash_lo), avalanche(hash_hi ^ P4) };
+    }
+
+    // fnOp(index) for [0, nCount), nChunk indices per task
+    template <typename FnOp>
+    static auto DedupeParallelFor(const std::size_t nCount, const std::size_t nThreads, const std::size_t nChunk, const FnOp& fnOp) -> void
+    {
+        if ((nThreads < 2) || (nCount <= nChunk)) { for (std::size_t index{}; index < nCount; index++) { fnOp(index); } return; }
+
+        Pool pool{ std::min(nThreads, (nCount + nChunk - 1) / nChunk) };
+        for (std::size_t beg{}; beg < nCount; beg += nChunk)
+        {
+            pool.Submit([&fnOp, beg, end = std::min(beg + nChunk, nCount)] { for (auto index{ beg }; index < end; index++) { fnOp(index); } });
+        }
+        pool.Wait();
+    }
+
+    // splits every bucket into runs of equal fnKey, runs of one inode are dropped
+    template <typename FnKey>
+    static auto DedupeSplit(const std::vector<std::vector<std::size_t>>& vcBuckets, const std::vector<DedupeInode>& vcInodes, const FnKey& fnKey) -> std::vector<std::vector<std::size_t>>
+    {
+        std::vector<std::vector<std::size_t>> buckets;
+        for (auto bucket : vcBuckets)
+        {
+            std::erase_if(bucket, [&vcInodes](const std::size_t nInode) { return vcInodes[nInode].IsValid == false; });
+            std::ranges::sort(bucket, {}, [&](const std::size_t nInode) { return fnKey(vcInodes[nInode]); });
+
+            for (std::size_t beg{}, end{}; beg < bucket.size(); beg = end)
+            {
+                for (end = beg + 1; (end < bucket.size()) && (fnKey(vcInodes[bucket[end]]) == fnKey(vcInodes[bucket[beg]])); end++) {}
+                if (end - beg > 1) { buckets.emplace_back(bucket.begin() + static_cast<std::ptrdiff_t>(beg), bucket.begin() + static_cast<std::ptrdiff_t>(end)); }
+            }
+        }
+        return buckets;
+    }
+
+    auto Dedupe::RunImp(const std::span<const std::string_view> spPaths, const std::size_t nThreads) -> bool
+    {
+        this->Clear();
+        const auto thread_count{ Pool::ThreadCount(nThreads) };
+
+        // stage 1: stat, candidates share a size with at least one other distinct file
+        std::vector<DedupeFile> files(spPaths.size());
+        DedupeParallelFor(files.size(), thread_count, 256, [&](const std::size_t nIndex)
+            {
+                files[nIndex].Path = spPaths[nIndex];
+                files[nIndex].IsValid = ZxFS::DedupeStat(spPaths[nIndex], files[nIndex]);
+            });
+        std::erase_if(files, [](const DedupeFile& rfFile) { return rfFile.IsValid == false; });
+        for (const auto& file : files) { m_nBytesTotal += file.Bytes; }
+        std::erase_if(files, [](const DedupeFile& rfFile) { return rfFile.Bytes == 0; });
+        std::ranges::sort(files, {}, [](const DedupeFile& rfFile) { return std::tuple{ rfFile.Bytes, rfFile.Dev, rfFile.Ino, rfFile.Path }; });
+
+        std::vector<DedupeInode> inodes;
+        for (std::size_t index{}; index < files.size(); index++)
+        {
+            if (!inodes.empty() && (files[inodes.back().FileBeg].Dev == files[index].Dev) && (files[inodes.back().FileBeg].Ino == files[index].Ino)) { inodes.back().FileEnd++; continue; }
+            inodes.emplace_back(DedupeInode{ .FileBeg = index, .FileEnd = index + 1, .Bytes = files[index].Bytes });
+        }
+
+        std::vector<std::vector<std::size_t>> buckets(1);
+        for (std::size_t index{}; index < inodes.size(); index++) { buckets.front().push_back(index); }
+        buckets = ZxFS::DedupeSplit(buckets, inodes, [](const DedupeInode& rfInode) { return rfInode.Bytes; });
+
+        std::atomic<std::uint64_t> bytes_read{};
+        std::atomic<bool> is_all_read{ true };
+
+        // stage 2: first and last block
+        std::vector<std::size_t> pending;
+        for (const auto& bucket : buckets) { pending.insert(pending.end(), bucket.begin(), bucket.end()); }
+        DedupeParallelFor(pending.size(), thread_count, 64, [&](const std::size_t nIndex)
+            {
+                auto& inode{ inodes[pending[nIndex]] };
+                std::array<std::byte, PARTIAL_BLOCK_BYTES * 2> buffer;
+                const auto head_bytes{ static_cast<std::size_t>(std::min<std::uint64_t>(inode.Bytes, PARTIAL_BLOCK_BYTES * 2)) };
+                const auto tail_bytes{ (inode.Bytes > PARTIAL_BLOCK_BYTES * 2) ? PARTIAL_BLOCK_BYTES : 0 };
+                const auto read_bytes{ (tail_bytes != 0) ? PARTIAL_BLOCK_BYTES : head_bytes };
+                inode.IsValid = ZxFS::DedupeRead(files[inode.FileBeg].Path, 0, buffer.data(), read_bytes, inode.Bytes - tail_bytes, buffer.data() + PARTIAL_BLOCK_BYTES, tail_bytes);
+                if (inode.IsValid) { inode.PartialHash = ZxFS::DedupeHashBytes({ buffer.data(), read_bytes + tail_bytes }); }
+                if (inode.IsValid == false) { is_all_read.store(false, std::memory_order_relaxed); }
+                bytes_read.fetch_add(inode.IsValid ? read_bytes + tail_bytes : 0, std::memory_order_relaxed);
+            });
+        buckets = ZxFS::DedupeSplit(buckets, inodes, [](const DedupeInode& rfInode) { return rfInode.PartialHash; });
+
+        // stage 3: whole content, one task per bucket. every file is mapped once, its hash picks the class and a byte
+        // compare with the class reference confirms it, so a hash match alone is never reported. pairs skip the hash.
+        std::vector<std::vector<std::vector<std::size_t>>> bucket_classes(buckets.size());
+        DedupeParallelFor(buckets.size(), thread_count, 1, [&](const std::size_t nBucket)
+            {
+                const auto is_hashed{ buckets[nBucket].size() > 2 };
+                std::vector<DedupeClass> classes;
+                for (const auto inode_index : buckets[nBucket])
+                {
+                    const auto& inode{ inodes[inode_index] };
+                    MappedFile mapped_file;
+                    if ((mapped_file.Open(files[inode.FileBeg].Path, false, MapHint::Sequential | MapHint::WillNeed) == false) || (mapped_file.GetSize() != inode.Bytes))
+                    {
+                        is_all_read.store(false, std::memory_order_relaxed);
+                        continue;
+                    }
+                    bytes_read.fetch_add(inode.Bytes, std::memory_order_relaxed);
+
+                    const auto span{ mapped_file.GetSpan() };
+                    const auto hash{ is_hashed ? ZxFS::DedupeHashBytes(span) : DedupeHash{} };
+                    const auto class_ite{ std::ranges::find_if(classes, [&](const DedupeClass& rfClass) { return (rfClass.Hash == hash) && (std::memcmp(rfClass.Reference.GetSpan().data(), span.data(), span.size()) == 0); }) };
+                    if (class_ite != classes.end()) { class_ite->Inodes.push_back(inode_index); continue; }
+                    classes.emplace_back(DedupeClass{ .Hash = hash, .Reference = std::move(mapped_file), .Inodes = { inode_index } });
+                }
+
+                for (auto& dedupe_class : classes)
+                {
+                    if (dedupe_class.Inodes.size() > 1) { bucket_classes[nBucket].emplace_back(std::move(dedupe_class.Inodes)); }
+                }
+            });
+        buckets.clear();
+        for (auto& classes : bucket_classes) { std::ranges::move(classes, std::back_inserter(buckets)); }
+        m_nBytesRead = bytes_read.load(std::memory_order_relaxed);
+
+        for (const auto& bucket : buckets)
+        {
+            auto& group{ m_vcGroups.emplace_back(Group{ .FileBytes = inodes[bucket.front()].Bytes, .Paths = {} }) };
+            for (const auto inode_index : bucket)
+            {
+                for (auto file_index{ inodes[inode_index].FileBeg }; file_index < inodes[inode_index].FileEnd; file_index++) { group.Paths.emplace_back(files[file_index].Path); }
+            }
+            std::ranges::sort(group.Paths);
+        }
+        std::ranges::sort(m_vcGroups, [](const Group& rfA, const Group& rfB) { return rfA.FileBytes != rfB.FileBytes ? rfA.FileBytes > rfB.FileBytes : rfA.Paths.front() < rfB.Paths.front(); });
+
+        return is_all_read.load(std::memory_order_relaxed);
+    }
+
+    auto Dedupe::Run(const std::span<const std::string> spPaths, const std::size_t nThreads) -> bool
+    {
+        const std::vector<std::string_view> paths{ spPaths.begin(), spPaths.end() };
+        return this->RunImp(paths, nThreads);
+    }
+
+    auto Dedupe::Run(const PathList& rfPaths, const std::size_t nThreads) -> bool
+    {
+        const std::vector<std::string_view> paths{ rfPaths.begin(), rfPaths.end() };
+        return this->RunImp(paths, nThreads);
+    }
+
+    auto Dedupe::Clear() -> void
+    {
+        m_vcGroups.clear();
+        m_nBytesTotal = 0;
+        m_nBytesRead = 0;
+    }
+
+    auto Dedupe::GetGroups() const -> const std::vector<Group>&
+    {
+        return m_vcGroups;
+    }
+
+    auto Dedupe::GetBytesTotal() const -> std::uint64_t
+    {
+        return m_nBytesTotal;
+    }
+
+    auto Dedupe::GetBytesRead() const -> std::uint64_t
+    {
+        return m_nBytesRead;
+    }
+} // namespace ZQF::Zut::ZxFS
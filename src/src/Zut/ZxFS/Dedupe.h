@@ -0,0 +1,50 @@
+#pragma once
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <Zut/ZxFS/PathList.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // groups byte-identical files in stages: size (stat), hash of the first and last block (pread), whole content (mapped,
+    // hashed and compared byte for byte with one reference per class, each file read once). the hashes only narrow the
+    // candidates, every reported group is confirmed byte for byte. every stage only reads what the previous one could not
+    // tell apart, each runs on nThreads workers.
+    // empty files, non-regular files (symlinks included, they are not followed) and groups that are only hardlinks of one file are not reported.
+    class Dedupe
+    {
+    public:
+        struct Group
+        {
+            std::uint64_t FileBytes{};
+            std::vector<std::string> Paths; // sorted, hardlinks of one file included
+        };
+
+        static constexpr std::size_t PARTIAL_BLOCK_BYTES{ 4096 };
+
+    private:
+        std::vector<Group> m_vcGroups;
+        std::uint64_t m_nBytesTotal{};
+        std::uint64_t m_nBytesRead{};
+
+    public:
+        Dedupe() = default;
+
+    public:
+        // false if a candidate could not be read (it is left out of the groups). nThreads == 0 -> std::thread::hardware_concurrency()
+        auto Run(const std::span<const std::string> spPaths, const std::size_t nThreads) -> bool;
+        auto Run(const PathList& rfPaths, const std::size_t nThreads) -> bool;
+        auto Clear() -> void;
+
+    public:
+        auto GetGroups() const -> const std::vector<Group>&; // largest files first
+        auto GetBytesTotal() const -> std::uint64_t;         // size of every regular file passed in
+        auto GetBytesRead() const -> std::uint64_t;          // what the hash and compare stages actually read
+
+    private:
+        auto RunImp(const std::span<const std::string_view> spPaths, const std::size_t nThreads) -> bool;
+    };
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,143 @@
+#include "Entry.h"
+#include "Probe.h"
+#include <string>
+#include <stdexcept>
+
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    auto Entry::Bind(const std::string_view msName, const std::uint32_t nAttributes, const std::uint64_t nSize, const std::uint64_t nWriteTime) -> void
+    {
+        m_msName = msName;
+        m_eType = (nAttributes & FILE_ATTRIBUTE_DIRECTORY) ? EntryType::Dir : EntryType::File;
+        m_nSize = nSize;
+        m_nMTime = (static_cast<std::int64_t>(nWriteTime) - 116444736000000000) * 100; // FILETIME (100ns since 1601) -> unix epoch ns
+        m_nIno = 0; // not part of the find data, would need a handle per entry
+        m_nLoadedFields = EntryField::All;
+    }
+
+    auto Entry::Load(const std::uint32_t /* nFields */) -> bool
+    {
+        return true;
+    }
+} // namespace ZQF::Zut::ZxFS
+#elif __linux__
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    static auto EntryTypeFromMode(const std::uint32_t nMode) -> EntryType
+    {
+        switch (nMode & S_IFMT)
+        {
+        case S_IFREG: return EntryType::File;
+        case S_IFDIR: return EntryType::Dir;
+        case S_IFLNK: return EntryType::Symlink;
+        default: return EntryType::Other;
+        }
+    }
+
+    auto Entry::Bind(const int nDirFD, const std::string_view msName, const std::uint8_t nDirentType, const std::uint64_t nIno, const std::uint32_t nStatFields) -> void
+    {
+        m_nDirFD = nDirFD;
+        m_msName = msName;
+        m_nIno = nIno;
+        m_nStatFields = nStatFields;
+        m_nLoadedFields = EntryField::Ino;
+
+        switch (nDirentType)
+        {
+        case DT_REG: m_eType = EntryType::File; break;
+        case DT_DIR: m_eType = EntryType::Dir; break;
+        case DT_LNK: m_eType = EntryType::Symlink; break;
+        case DT_UNKNOWN:
+        {
+            // only filesystems that do not fill d_type pay for the extra stat
+            m_eType = EntryType::Unknown;
+            this->Load(m_nStatFields);
+            break;
+        }
+        default: m_eType = EntryType::Other;
+        }
+    }
+
+    auto Entry::Load(const std::uint32_t nFields) -> bool
+    {
+        const auto want_fields{ (nFields | m_nStatFields) & ~m_nLoadedFields };
+        if ((want_fields == EntryField::None) && (m_eType != EntryType::Unknown)) { return true; }
+
+        unsigned int statx_mask{};
+        if (m_eType == EntryType::Unknown) { statx_mask |= STATX_TYPE; }
+        if (want_fields & EntryField::Size) { statx_mask |= STATX_SIZE; }
+        if (want_fields & EntryField::MTime) { statx_mask |= STATX_MTIME; }
+        if (want_fields & EntryField::Ino) { statx_mask |= STATX_INO; }
+
+        struct statx stx;
+        if (ZXFS_STAT_CALL(Stat, ::statx(m_nDirFD, m_msName.data(), AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT, statx_mask, &stx)) == -1) { return false; }
+
+        if (m_eType == EntryType::Unknown) { m_eType = EntryTypeFromMode(stx.stx_mode); }
+        if (want_fields & EntryField::Size) { m_nSize = stx.stx_size; }
+        if (want_fields & EntryField::MTime) { m_nMTime = static_cast<std::int64_t>(stx.stx_mtime.tv_sec) * 1000000000 + stx.stx_mtime.tv_nsec; }
+        if (want_fields & EntryField::Ino) { m_nIno = stx.stx_ino; }
+        m_nLoadedFields |= want_fields;
+
+        return true;
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
+
+
+namespace ZQF::Zut::ZxFS
+{
+    auto Entry::GetName() const -> std::string_view
+    {
+        return m_msName;
+    }
+
+    auto Entry::GetType() const -> EntryType
+    {
+        return m_eType;
+    }
+
+    auto Entry::IsFile() const -> bool
+    {
+        return m_eType == EntryType::File;
+    }
+
+    auto Entry::IsDir() const -> bool
+    {
+        return m_eType == EntryType::Dir;
+    }
+
+    auto Entry::GetSize() -> std::uint64_t
+    {
+        this->LoadOrThrow(EntryField::Size);
+        return m_nSize;
+    }
+
+    auto Entry::GetMTime() -> std::int64_t
+    {
+        this->LoadOrThrow(EntryField::MTime);
+        return m_nMTime;
+    }
+
+    auto Entry::GetIno() -> std::uint64_t
+    {
+        this->LoadOrThrow(EntryField::Ino);
+        return m_nIno;
+    }
+
+    auto Entry::LoadOrThrow(const std::uint32_t nField) -> void
+    {
+        if (m_nLoadedFields & nField) { return; }
+        if (this->Load(nField) == false) { throw std::runtime_error(std::string{ "ZxFS::Entry: stat error! -> " }.append(m_msName)); }
+    }
+} // namespace ZQF::Zut::ZxFS
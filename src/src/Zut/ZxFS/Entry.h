@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    enum class EntryType : std::uint8_t
+    {
+        Unknown,
+        File,
+        Dir,
+        Symlink,
+        Other
+    };
+
+    // metadata fields fetched together on the first lazy load
+    struct EntryField
+    {
+        static constexpr std::uint32_t None{ 0x0 };
+        static constexpr std::uint32_t Size{ 0x1 };
+        static constexpr std::uint32_t MTime{ 0x2 };
+        static constexpr std::uint32_t Ino{ 0x4 };
+        static constexpr std::uint32_t All{ Size | MTime | Ino };
+    };
+
+    // a directory entry handed out by Walker / Searcher, valid until the scan moves on.
+    // the type comes from the directory read itself, size / mtime / inode are fetched lazily
+    // with one statx relative to the parent directory fd (on windows they come with the find data).
+    class Entry
+    {
+    private:
+        std::string_view m_msName{};
+        EntryType m_eType{};
+        std::uint32_t m_nStatFields{};
+        std::uint32_t m_nLoadedFields{};
+        std::uint64_t m_nSize{};
+        std::int64_t m_nMTime{};
+        std::uint64_t m_nIno{};
+        int m_nDirFD{ -1 };
+
+    public:
+        Entry() = default;
+
+    public:
+#ifdef _WIN32
+        auto Bind(const std::string_view msName, const std::uint32_t nAttributes, const std::uint64_t nSize, const std::uint64_t nWriteTime) -> void;
+#elif __linux__
+        auto Bind(const int nDirFD, const std::string_view msName, const std::uint8_t nDirentType, const std::uint64_t nIno, const std::uint32_t nStatFields) -> void;
+#endif
+        auto Load(const std::uint32_t nFields) -> bool;
+
+    public:
+        auto GetName() const -> std::string_view;
+        auto GetType() const -> EntryType;
+        auto IsFile() const -> bool;
+        auto IsDir() const -> bool;
+        auto GetSize() -> std::uint64_t;
+        auto GetMTime() -> std::int64_t; // nanoseconds since unix epoch
+        auto GetIno() -> std::uint64_t;
+
+    private:
+        auto LoadOrThrow(const std::uint32_t nField) -> void;
+    };
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,207 @@
+#include "Filter.h"
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZXFS_FILTER_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define ZXFS_FILTER_AVX2
+#include <immintrin.h>
+#endif
+
+
+namespace ZQF::Zut::ZxFS
+{
+    static constexpr auto ToLowerASCII(const char cChar) -> char
+    {
+        return (cChar >= 'A' && cChar <= 'Z') ? static_cast<char>(cChar | 0x20) : cChar;
+    }
+
+    static auto IsGlobMatchImp(const std::string_view msGlob, const std::string_view msName, const bool isIgnoreCase) -> bool
+    {
+        // iterative wildcard match, backtracks to the last '*' only.
+        std::size_t glob_pos{}, name_pos{};
+        std::size_t star_pos{ std::string_view::npos }, star_name_pos{};
+
+        while (name_pos < msName.size())
+        {
+            if (glob_pos < msGlob.size() && msGlob[glob_pos] == '*')
+            {
+                star_pos = glob_pos++;
+                star_name_pos = name_pos;
+            }
+            else if (glob_pos < msGlob.size() && (msGlob[glob_pos] == '?' || (isIgnoreCase ? ToLowerASCII(msGlob[glob_pos]) == ToLowerASCII(msName[name_pos]) : msGlob[glob_pos] == msName[name_pos])))
+            {
+                glob_pos++;
+                name_pos++;
+            }
+            else if (star_pos != std::string_view::npos)
+            {
+                glob_pos = star_pos + 1;
+                name_pos = ++star_name_pos;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while (glob_pos < msGlob.size() && msGlob[glob_pos] == '*') { glob_pos++; }
+        return glob_pos == msGlob.size();
+    }
+
+
+    Filter::Filter(const Filter& rfFilter) : m_isIgnoreCase{ rfFilter.m_isIgnoreCase }, m_vcSuffixes{ rfFilter.m_vcSuffixes }, m_vcGlobs{ rfFilter.m_vcGlobs }
+    {
+        this->Build();
+    }
+
+    Filter::Filter(std::initializer_list<std::string_view> ilSuffixes, const bool isIgnoreCase) : m_isIgnoreCase{ isIgnoreCase }
+    {
+        for (const auto suffix : ilSuffixes) { m_vcSuffixes.emplace_back(suffix); }
+        this->Build();
+    }
+
+    auto Filter::operator=(const Filter& rfFilter) -> Filter&
+    {
+        if (this == &rfFilter) { return *this; }
+        m_isIgnoreCase = rfFilter.m_isIgnoreCase;
+        m_vcSuffixes = rfFilter.m_vcSuffixes;
+        m_vcGlobs = rfFilter.m_vcGlobs;
+        this->Build();
+        return *this;
+    }
+
+    auto Filter::AddSuffix(const std::string_view msSuffix) -> Filter&
+    {
+        m_vcSuffixes.emplace_back(msSuffix);
+        this->Build();
+        return *this;
+    }
+
+    auto Filter::AddGlob(const std::string_view msGlob) -> Filter&
+    {
+        m_vcGlobs.emplace_back(msGlob);
+        return *this;
+    }
+
+    auto Filter::SetIgnoreCase(const bool isIgnoreCase) -> Filter&
+    {
+        m_isIgnoreCase = isIgnoreCase;
+        this->Build();
+        return *this;
+    }
+
+    auto Filter::Build() -> void
+    {
+        m_vcSuffixTails.clear();
+        m_vcSuffixMasks.clear();
+        m_vcLongSuffixes.clear();
+
+        // the user's suffixes keep their case, only the derived tables are lowered, so SetIgnoreCase(false) can undo it
+        std::string suffix;
+        for (const auto& user_suffix : m_vcSuffixes)
+        {
+            suffix.assign(user_suffix);
+            if (m_isIgnoreCase) { std::ranges::transform(suffix, suffix.begin(), ToLowerASCII); }
+
+            if (suffix.size() > 16 || suffix.empty())
+            {
+                m_vcLongSuffixes.emplace_back(suffix);
+                continue;
+            }
+
+            auto& tail{ m_vcSuffixTails.emplace_back() };
+            auto& mask{ m_vcSuffixMasks.emplace_back() };
+            tail.fill(0);
+            mask.fill(0);
+            std::memcpy(tail.data() + 16 - suffix.size(), suffix.data(), suffix.size());
+            std::fill(mask.begin() + static_cast<std::ptrdiff_t>(16 - suffix.size()), mask.end(), std::uint8_t{ 0xFF });
+        }
+
+#ifdef ZXFS_FILTER_AVX2
+        // pad to an even count so the avx2 loop can always test two suffixes at once
+        if (m_vcSuffixTails.size() % 2)
+        {
+            m_vcSuffixTails.push_back(m_vcSuffixTails.back());
+            m_vcSuffixMasks.push_back(m_vcSuffixMasks.back());
+        }
+#endif
+    }
+
+    auto Filter::IsEmpty() const -> bool
+    {
+        return m_vcSuffixes.empty() && m_vcGlobs.empty();
+    }
+
+    auto Filter::IsMatch(const std::string_view msName) const -> bool
+    {
+        if (this->IsEmpty()) { return true; }
+        return this->IsSuffixMatch(msName) || this->IsGlobMatch(msName);
+    }
+
+    auto Filter::IsSuffixMatch(const std::string_view msName) const -> bool
+    {
+        // last (up to) 16 bytes of the name, right aligned, zero padded at the front.
+        // suffix bytes are never zero, so a name shorter than the suffix can not match the padding.
+        alignas(16) std::uint8_t name_tail[16]{};
+        const auto tail_bytes{ std::min<std::size_t>(msName.size(), 16) };
+        std::memcpy(name_tail + 16 - tail_bytes, msName.data() + msName.size() - tail_bytes, tail_bytes);
+
+#if defined(ZXFS_FILTER_SSE2)
+        auto tail_vec{ _mm_load_si128(reinterpret_cast<const __m128i*>(name_tail)) };
+        if (m_isIgnoreCase)
+        {
+            const auto is_upper{ _mm_and_si128(_mm_cmpgt_epi8(tail_vec, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(tail_vec, _mm_set1_epi8('Z' + 1))) };
+            tail_vec = _mm_or_si128(tail_vec, _mm_and_si128(is_upper, _mm_set1_epi8(0x20)));
+        }
+
+        std::size_t index{};
+#if defined(ZXFS_FILTER_AVX2)
+        const auto tail_vec_x2{ _mm256_broadcastsi128_si256(tail_vec) };
+        for (; index + 2 <= m_vcSuffixTails.size(); index += 2)
+        {
+            const auto suffix_vec{ _mm256_loadu2_m128i(reinterpret_cast<const __m128i*>(m_vcSuffixTails[index + 1].data()), reinterpret_cast<const __m128i*>(m_vcSuffixTails[index].data())) };
+            const auto mask_vec{ _mm256_loadu2_m128i(reinterpret_cast<const __m128i*>(m_vcSuffixMasks[index + 1].data()), reinterpret_cast<const __m128i*>(m_vcSuffixMasks[index].data())) };
+            const auto miss_bits{ static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_xor_si256(_mm256_cmpeq_epi8(tail_vec_x2, suffix_vec), _mm256_set1_epi8(-1)), mask_vec))) };
+            if ((miss_bits & 0x0000FFFF) == 0 || (miss_bits & 0xFFFF0000) == 0) { return true; }
+        }
+#endif
+        for (; index < m_vcSuffixTails.size(); index++)
+        {
+            const auto suffix_vec{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_vcSuffixTails[index].data())) };
+            const auto mask_vec{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_vcSuffixMasks[index].data())) };
+            if (_mm_movemask_epi8(_mm_andnot_si128(_mm_cmpeq_epi8(tail_vec, suffix_vec), mask_vec)) == 0) { return true; }
+        }
+#else
+        if (m_isIgnoreCase) { for (auto& c : name_tail) { c = static_cast<std::uint8_t>(ToLowerASCII(static_cast<char>(c))); } }
+
+        for (std::size_t index{}; index < m_vcSuffixTails.size(); index++)
+        {
+            bool is_match{ true };
+            for (std::size_t byte_index{}; byte_index < 16 && is_match; byte_index++)
+            {
+                is_match = (m_vcSuffixMasks[index][byte_index] == 0) || (m_vcSuffixTails[index][byte_index] == name_tail[byte_index]);
+            }
+            if (is_match) { return true; }
+        }
+#endif
+
+        for (const auto& suffix : m_vcLongSuffixes)
+        {
+            if (suffix.size() > msName.size()) { continue; }
+            const auto name_tail_sv{ msName.substr(msName.size() - suffix.size()) };
+            if (m_isIgnoreCase ? std::ranges::equal(name_tail_sv, suffix, {}, ToLowerASCII) : name_tail_sv == suffix) { return true; }
+        }
+
+        return false;
+    }
+
+    auto Filter::IsGlobMatch(const std::string_view msName) const -> bool
+    {
+        return std::ranges::any_of(m_vcGlobs, [this, msName](const std::string& msGlob) { return IsGlobMatchImp(msGlob, msName, m_isIgnoreCase); });
+    }
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // file name filter evaluated inside the scan loop, before any path string is built.
+    // a name passes when it ends with any suffix or matches any glob ('*', '?'), an empty filter passes everything.
+    class Filter
+    {
+    private:
+        bool m_isIgnoreCase{};
+        std::vector<std::string> m_vcSuffixes;
+        std::vector<std::string> m_vcGlobs;
+        std::vector<std::array<std::uint8_t, 16>> m_vcSuffixTails; // suffixes <= 16 bytes, right aligned for simd compare, lowered when ignoring case
+        std::vector<std::array<std::uint8_t, 16>> m_vcSuffixMasks;
+        std::vector<std::string> m_vcLongSuffixes;
+
+    public:
+        Filter() = default;
+        Filter(const Filter& rfFilter);
+        Filter(std::initializer_list<std::string_view> ilSuffixes, const bool isIgnoreCase = false);
+        auto operator=(const Filter& rfFilter) -> Filter&;
+
+    public:
+        auto AddSuffix(const std::string_view msSuffix) -> Filter&;
+        auto AddGlob(const std::string_view msGlob) -> Filter&;
+        auto SetIgnoreCase(const bool isIgnoreCase) -> Filter&;
+
+    public:
+        auto IsEmpty() const -> bool;
+        auto IsMatch(const std::string_view msName) const -> bool;
+
+    private:
+        auto Build() -> void;
+        auto IsSuffixMatch(const std::string_view msName) const -> bool;
+        auto IsGlobMatch(const std::string_view msName) const -> bool;
+    };
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,191 @@
+#include "MappedFile.h"
+#include <string>
+#include <utility>
+#include <stdexcept>
+
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include "Plat.h"
+
+
+namespace ZQF::Zut::ZxFS
+{
+    auto MappedFile::Open(const std::string_view msPath, const bool isWritable, const std::uint32_t nHints) -> bool
+    {
+        this->Close();
+
+        const auto hfile = ::CreateFileW(Plat::PathUTF8ToWide(msPath).second.get(), isWritable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, (nHints & MapHint::Sequential) ? FILE_FLAG_SEQUENTIAL_SCAN : ((nHints & MapHint::Random) ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL), nullptr);
+        if (hfile == INVALID_HANDLE_VALUE) { return false; }
+
+        LARGE_INTEGER file_size;
+        if (::GetFileSizeEx(hfile, &file_size) == FALSE) { ::CloseHandle(hfile); return false; }
+
+        m_isOpen = true;
+        m_isWritable = isWritable;
+        if (file_size.QuadPart == 0) { ::CloseHandle(hfile); return true; }
+
+        const auto hmapping = ::CreateFileMappingW(hfile, nullptr, isWritable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(hfile);
+        if (hmapping == nullptr) { this->Close(); return false; }
+
+        const auto view_ptr = ::MapViewOfFile(hmapping, isWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+        if (view_ptr == nullptr) { ::CloseHandle(hmapping); this->Close(); return false; }
+
+        m_pData = static_cast<std::byte*>(view_ptr);
+        m_nBytes = static_cast<std::size_t>(file_size.QuadPart);
+        m_hMapping = reinterpret_cast<std::uintptr_t>(hmapping);
+        this->Advise(nHints);
+
+        return true;
+    }
+
+    auto MappedFile::Close() -> void
+    {
+        if (m_pData != nullptr) { ::UnmapViewOfFile(m_pData); }
+        if (m_hMapping != 0) { ::CloseHandle(reinterpret_cast<HANDLE>(m_hMapping)); }
+        m_pData = nullptr;
+        m_nBytes = 0;
+        m_hMapping = 0;
+        m_isOpen = false;
+        m_isWritable = false;
+    }
+
+    auto MappedFile::Advise(const std::uint32_t nHints) -> bool
+    {
+        if (m_pData == nullptr) { return true; }
+        if ((nHints & (MapHint::WillNeed | MapHint::Populate)) == 0) { return true; }
+
+        WIN32_MEMORY_RANGE_ENTRY range{ m_pData, m_nBytes };
+        return ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0) != FALSE;
+    }
+
+    auto MappedFile::Flush() -> bool
+    {
+        if (m_pData == nullptr) { return true; }
+        return ::FlushViewOfFile(m_pData, 0) != FALSE;
+    }
+} // namespace ZQF::Zut::ZxFS
+#elif __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    auto MappedFile::Open(const std::string_view msPath, const bool isWritable, const std::uint32_t nHints) -> bool
+    {
+        this->Close();
+
+        const auto fd = ::open(msPath.data(), (isWritable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        if (fd == -1) { return false; }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1) { ::close(fd); return false; }
+
+        m_isOpen = true;
+        m_isWritable = isWritable;
+        if (st.st_size == 0) { ::close(fd); return true; }
+
+        const auto map_flags{ MAP_SHARED | ((nHints & MapHint::Populate) ? MAP_POPULATE : 0) };
+        const auto map_ptr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), isWritable ? (PROT_READ | PROT_WRITE) : PROT_READ, map_flags, fd, 0);
+        ::close(fd); // the mapping keeps its own reference
+        if (map_ptr == MAP_FAILED) { this->Close(); return false; }
+
+        m_pData = static_cast<std::byte*>(map_ptr);
+        m_nBytes = static_cast<std::size_t>(st.st_size);
+        this->Advise(nHints);
+
+        return true;
+    }
+
+    auto MappedFile::Close() -> void
+    {
+        if (m_pData != nullptr) { ::munmap(m_pData, m_nBytes); }
+        m_pData = nullptr;
+        m_nBytes = 0;
+        m_isOpen = false;
+        m_isWritable = false;
+    }
+
+    auto MappedFile::Advise(const std::uint32_t nHints) -> bool
+    {
+        if (m_pData == nullptr) { return true; }
+
+        bool status{ true };
+        if (nHints & MapHint::Sequential) { status &= ::madvise(m_pData, m_nBytes, MADV_SEQUENTIAL) != -1; }
+        if (nHints & MapHint::Random) { status &= ::madvise(m_pData, m_nBytes, MADV_RANDOM) != -1; }
+        if (nHints & MapHint::WillNeed) { status &= ::madvise(m_pData, m_nBytes, MADV_WILLNEED) != -1; }
+#ifdef MADV_HUGEPAGE
+        if (nHints & MapHint::HugePages) { status &= ::madvise(m_pData, m_nBytes, MADV_HUGEPAGE) != -1; } // only takes effect where the fs supports huge page cache
+#endif
+        return status;
+    }
+
+    auto MappedFile::Flush() -> bool
+    {
+        if (m_pData == nullptr || m_isWritable == false) { return true; }
+        return ::msync(m_pData, m_nBytes, MS_SYNC) != -1;
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
+
+
+namespace ZQF::Zut::ZxFS
+{
+    MappedFile::MappedFile(const std::string_view msPath, const bool isWritable, const std::uint32_t nHints)
+    {
+        if (this->Open(msPath, isWritable, nHints) == false) { throw std::runtime_error(std::string{ "ZxFS::MappedFile::MappedFile(): map file error! -> " }.append(msPath)); }
+    }
+
+    MappedFile::MappedFile(MappedFile&& rfOther) noexcept
+        : m_pData{ std::exchange(rfOther.m_pData, nullptr) }, m_nBytes{ std::exchange(rfOther.m_nBytes, 0) }, m_isOpen{ std::exchange(rfOther.m_isOpen, false) }, m_isWritable{ std::exchange(rfOther.m_isWritable, false) }, m_hMapping{ std::exchange(rfOther.m_hMapping, 0) }
+    {
+
+    }
+
+    auto MappedFile::operator=(MappedFile&& rfOther) noexcept -> MappedFile&
+    {
+        if (this == &rfOther) { return *this; }
+        this->Close();
+        m_pData = std::exchange(rfOther.m_pData, nullptr);
+        m_nBytes = std::exchange(rfOther.m_nBytes, 0);
+        m_isOpen = std::exchange(rfOther.m_isOpen, false);
+        m_isWritable = std::exchange(rfOther.m_isWritable, false);
+        m_hMapping = std::exchange(rfOther.m_hMapping, 0);
+        return *this;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        this->Close();
+    }
+
+    auto MappedFile::IsOpen() const -> bool
+    {
+        return m_isOpen;
+    }
+
+    auto MappedFile::IsWritable() const -> bool
+    {
+        return m_isWritable;
+    }
+
+    auto MappedFile::GetSize() const -> std::size_t
+    {
+        return m_nBytes;
+    }
+
+    auto MappedFile::GetSpan() const -> std::span<const std::byte>
+    {
+        return { m_pData, m_nBytes };
+    }
+
+    auto MappedFile::GetWritableSpan() -> std::span<std::byte>
+    {
+        return m_isWritable ? std::span<std::byte>{ m_pData, m_nBytes } : std::span<std::byte>{};
+    }
+} // namespace ZQF::Zut::ZxFS
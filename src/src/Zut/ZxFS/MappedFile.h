@@ -0,0 +1,53 @@
+#pragma once
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // access pattern hints, mapped to madvise / MAP_POPULATE (PrefetchVirtualMemory on windows)
+    struct MapHint
+    {
+        static constexpr std::uint32_t None{ 0x0 };
+        static constexpr std::uint32_t Sequential{ 0x1 };
+        static constexpr std::uint32_t Random{ 0x2 };
+        static constexpr std::uint32_t WillNeed{ 0x4 };
+        static constexpr std::uint32_t HugePages{ 0x8 };
+        static constexpr std::uint32_t Populate{ 0x10 }; // fault every page in at map time
+    };
+
+    // RAII view of a whole file, an empty file maps to an empty span.
+    class MappedFile
+    {
+    private:
+        std::byte* m_pData{};
+        std::size_t m_nBytes{};
+        bool m_isOpen{};
+        bool m_isWritable{};
+        std::uintptr_t m_hMapping{};
+
+    public:
+        MappedFile() = default;
+        MappedFile(const std::string_view msPath, const bool isWritable = false, const std::uint32_t nHints = MapHint::None);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&& rfOther) noexcept;
+        auto operator=(const MappedFile&) -> MappedFile& = delete;
+        auto operator=(MappedFile&& rfOther) noexcept -> MappedFile&;
+        ~MappedFile();
+
+    public:
+        auto Open(const std::string_view msPath, const bool isWritable = false, const std::uint32_t nHints = MapHint::None) -> bool;
+        auto Close() -> void;
+        auto Advise(const std::uint32_t nHints) -> bool;
+        auto Flush() -> bool;
+
+    public:
+        auto IsOpen() const -> bool;
+        auto IsWritable() const -> bool;
+        auto GetSize() const -> std::size_t;
+        auto GetSpan() const -> std::span<const std::byte>;
+        auto GetWritableSpan() -> std::span<std::byte>; // empty when mapped read-only
+    };
+} // namespace ZQF::Zut::ZxFS
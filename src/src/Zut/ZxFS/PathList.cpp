@@ -0,0 +1,81 @@
+#include "PathList.h"
+
+
+namespace ZQF::Zut::ZxFS
+{
+    auto PathList::reserve(const std::size_t nPaths, const std::size_t nBytes) -> void
+    {
+        m_vcOffsets.reserve(nPaths + 1);
+        m_vcArena.reserve(nBytes + nPaths);
+    }
+
+    auto PathList::clear() -> void
+    {
+        m_vcArena.clear();
+        m_vcOffsets.resize(1);
+    }
+
+    auto PathList::emplace_back(const char* cpPath, const std::size_t nBytes) -> void
+    {
+        m_vcArena.insert(m_vcArena.end(), cpPath, cpPath + nBytes);
+        m_vcArena.push_back('\0');
+        m_vcOffsets.push_back(m_vcArena.size());
+    }
+
+    auto PathList::emplace_back(const std::string_view msPath) -> void
+    {
+        this->emplace_back(msPath.data(), msPath.size());
+    }
+
+    auto PathList::push_back(const std::string_view msPath) -> void
+    {
+        this->emplace_back(msPath.data(), msPath.size());
+    }
+
+    auto PathList::append(const PathList& rfPaths) -> void
+    {
+        const auto arena_bytes{ m_vcArena.size() };
+        m_vcArena.insert(m_vcArena.end(), rfPaths.m_vcArena.begin(), rfPaths.m_vcArena.end());
+        m_vcOffsets.reserve(m_vcOffsets.size() + rfPaths.size());
+        for (auto ite = rfPaths.m_vcOffsets.begin() + 1; ite != rfPaths.m_vcOffsets.end(); ite++) { m_vcOffsets.push_back(arena_bytes + *ite); }
+    }
+
+    auto PathList::size() const -> std::size_t
+    {
+        return m_vcOffsets.size() - 1;
+    }
+
+    auto PathList::bytes() const -> std::size_t
+    {
+        return m_vcArena.size();
+    }
+
+    auto PathList::empty() const -> bool
+    {
+        return m_vcOffsets.size() == 1;
+    }
+
+    auto PathList::operator[](const std::size_t nIndex) const -> std::string_view
+    {
+        const auto beg{ m_vcOffsets[nIndex] };
+        return { m_vcArena.data() + beg, m_vcOffsets[nIndex + 1] - beg - 1 };
+    }
+
+    auto PathList::begin() const -> Iterator
+    {
+        return { this, 0 };
+    }
+
+    auto PathList::end() const -> Iterator
+    {
+        return { this, this->size() };
+    }
+
+    auto PathList::to_vector() const -> std::vector<std::string>
+    {
+        std::vector<std::string> paths;
+        paths.reserve(this->size());
+        for (const auto path : *this) { paths.emplace_back(path); }
+        return paths;
+    }
+} // namespace ZQF::Zut::ZxFS
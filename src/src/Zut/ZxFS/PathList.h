@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // all paths live in one contiguous arena, each one null-terminated, indexed by an offset table.
+    class PathList
+    {
+    private:
+        std::vector<char> m_vcArena;
+        std::vector<std::size_t> m_vcOffsets{ 0 };
+
+    public:
+        class Iterator
+        {
+        private:
+            const PathList* m_pList{};
+            std::size_t m_nIndex{};
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::string_view;
+            using pointer = void;
+
+        public:
+            Iterator() = default;
+            Iterator(const PathList* pList, const std::size_t nIndex) : m_pList{ pList }, m_nIndex{ nIndex } {}
+
+        public:
+            auto operator*() const -> std::string_view { return (*m_pList)[m_nIndex]; }
+            auto operator[](const difference_type nOffset) const -> std::string_view { return (*m_pList)[m_nIndex + nOffset]; }
+            auto operator++() -> Iterator& { m_nIndex++; return *this; }
+            auto operator--() -> Iterator& { m_nIndex--; return *this; }
+            auto operator++(int) -> Iterator { auto tmp{ *this }; m_nIndex++; return tmp; }
+            auto operator--(int) -> Iterator { auto tmp{ *this }; m_nIndex--; return tmp; }
+            auto operator+=(const difference_type nOffset) -> Iterator& { m_nIndex += nOffset; return *this; }
+            auto operator-=(const difference_type nOffset) -> Iterator& { m_nIndex -= nOffset; return *this; }
+            auto operator+(const difference_type nOffset) const -> Iterator { return { m_pList, m_nIndex + nOffset }; }
+            auto operator-(const difference_type nOffset) const -> Iterator { return { m_pList, m_nIndex - nOffset }; }
+            auto operator-(const Iterator& rhs) const -> difference_type { return static_cast<difference_type>(m_nIndex) - static_cast<difference_type>(rhs.m_nIndex); }
+            auto operator==(const Iterator& rhs) const -> bool { return m_nIndex == rhs.m_nIndex; }
+            auto operator<=>(const Iterator& rhs) const { return m_nIndex <=> rhs.m_nIndex; }
+            friend auto operator+(const difference_type nOffset, const Iterator& rhs) -> Iterator { return rhs + nOffset; }
+        };
+
+    public:
+        auto reserve(const std::size_t nPaths, const std::size_t nBytes) -> void;
+        auto clear() -> void;
+
+    public:
+        auto emplace_back(const char* cpPath, const std::size_t nBytes) -> void;
+        auto emplace_back(const std::string_view msPath) -> void;
+        auto push_back(const std::string_view msPath) -> void;
+        auto append(const PathList& rfPaths) -> void;
+
+    public:
+        auto size() const -> std::size_t;
+        auto bytes() const -> std::size_t;
+        auto empty() const -> bool;
+        auto operator[](const std::size_t nIndex) const -> std::string_view;
+        auto begin() const -> Iterator;
+        auto end() const -> Iterator;
+        auto to_vector() const -> std::vector<std::string>;
+    };
+} // namespace ZQF::Zut::ZxFS
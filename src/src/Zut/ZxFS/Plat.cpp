@@ -1,4 +1,6 @@
 #include "Plat.h"
+#include "Probe.h"
+#include <string>
 
 
 #ifdef _WIN32
@@ -38,9 +40,29 @@ namespace ZQF::Zut::ZxFS::Plat
         cpBuffer[bytes] = {};
         return bytes;
     }
+
+    auto FileReplaceDurable(const std::string_view msTempPath, const std::string_view msPath) -> bool
+    {
+        const auto [temp_path_w, temp_path_w_buffer] = Plat::PathUTF8ToWide(msTempPath);
+        const auto hfile{ ::CreateFileW(temp_path_w_buffer.get(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        if (hfile == INVALID_HANDLE_VALUE) { return false; }
+        const auto is_flushed{ ::FlushFileBuffers(hfile) != FALSE };
+        ::CloseHandle(hfile);
+        if (is_flushed == false) { return false; }
+
+        // rename() does not replace an existing file on windows
+        return ::MoveFileExW(temp_path_w_buffer.get(), Plat::PathUTF8ToWide(msPath).second.get(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+    }
 } // namespace ZQF::Zut::ZxFS::Plat
 #elif __linux__
 #include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <bit>
+#include <cstring>
+#include <cstddef>
 
 
 namespace ZQF::Zut::ZxFS::Plat
@@ -50,5 +72,185 @@ namespace ZQF::Zut::ZxFS::Plat
         const auto path_max_byte_ret{ ::pathconf("/", _PC_PATH_MAX) };
         return static_cast<std::size_t>(path_max_byte_ret == -1 ? PATH_MAX : path_max_byte_ret);
     }
+
+
+    struct linux_dirent64
+    {
+        std::uint64_t d_ino;
+        std::int64_t d_off;
+        std::uint16_t d_reclen;
+        std::uint8_t d_type;
+        char d_name[1];
+    };
+
+    constexpr auto DIRENT64_NAME_OFFSET{ offsetof(linux_dirent64, d_name) };
+
+
+    DirReader::DirReader(const std::size_t nBufferBytes) : m_nBufferBytes{ nBufferBytes }, m_upBuffer{ std::make_unique_for_overwrite<std::byte[]>(nBufferBytes) }
+    {
+
+    }
+
+    DirReader::~DirReader()
+    {
+        this->Close();
+    }
+
+    auto FileReplaceDurable(const std::string_view msTempPath, const std::string_view msPath) -> bool
+    {
+        const auto temp_path{ std::string{ msTempPath } };
+        const auto fd{ ::open(temp_path.c_str(), O_RDONLY | O_CLOEXEC) };
+        if (fd == -1) { return false; }
+        const auto is_synced{ ::fsync(fd) != -1 };
+        ::close(fd);
+        const auto path{ std::string{ msPath } };
+        if ((is_synced == false) || (::rename(temp_path.c_str(), path.c_str()) == -1)) { return false; }
+
+        // the rename lives in the parent directory, it is only durable once that is flushed too
+        const auto name_pos{ path.rfind('/') };
+        const auto dir_path{ name_pos == std::string::npos ? std::string{ "." } : (name_pos == 0 ? std::string{ "/" } : path.substr(0, name_pos)) };
+        const auto dir_fd{ ::open(dir_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+        if (dir_fd == -1) { return false; }
+        const auto is_dir_synced{ ::fsync(dir_fd) != -1 };
+        ::close(dir_fd);
+        return is_dir_synced;
+    }
+
+    auto DirReader::Open(const char* cpPath) -> bool
+    {
+        return this->Open(AT_FDCWD, cpPath);
+    }
+
+    auto DirReader::Open(const int nDirFD, const char* cpName) -> bool
+    {
+        this->Close();
+        m_nFD = ZXFS_STAT_CALL(OpenDir, ::openat(nDirFD, cpName, O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (m_nFD == -1) { return false; }
+        ZXFS_STAT_INC(DirVisited);
+        return true;
+    }
+
+    auto DirReader::Attach(const int nDirFD) -> void
+    {
+        this->Close();
+        ZXFS_STAT_INC(DirVisited);
+        m_nFD = nDirFD;
+    }
+
+    auto DirReader::Detach() -> int
+    {
+        const auto fd{ m_nFD };
+        m_nFD = -1;
+        m_nReadBytes = 0;
+        m_nReadPos = 0;
+        m_pEntry = nullptr;
+        m_isFailed = false;
+        return fd;
+    }
+
+    auto DirReader::Close() -> bool
+    {
+        if (m_nFD == -1) { return true; }
+        const auto status{ ::close(m_nFD) };
+        m_nFD = -1;
+        m_nReadBytes = 0;
+        m_nReadPos = 0;
+        m_pEntry = nullptr;
+        m_isFailed = false;
+        return status != -1;
+    }
+
+    auto DirReader::Next() -> bool
+    {
+        while (true)
+        {
+            if (m_nReadPos >= m_nReadBytes)
+            {
+                const auto read_bytes{ ZXFS_STAT_CALL(ReadDir, ::syscall(SYS_getdents64, m_nFD, m_upBuffer.get(), m_nBufferBytes)) };
+                if (read_bytes <= 0) { m_pEntry = nullptr; m_isFailed = (read_bytes == -1); return false; }
+                m_nReadBytes = static_cast<std::size_t>(read_bytes);
+                m_nReadPos = 0;
+            }
+
+            const auto entry_ptr{ m_upBuffer.get() + m_nReadPos };
+            const auto entry_bytes{ reinterpret_cast<const linux_dirent64*>(entry_ptr)->d_reclen };
+            m_nReadPos += entry_bytes;
+
+            // the name terminator lies in the last 8 bytes of the record (records are 8-byte aligned),
+            // so find it with one word instead of strlen. bytes before d_name are forced non-zero.
+            std::size_t name_end{};
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                const auto word_pos{ entry_bytes - sizeof(std::uint64_t) };
+                std::uint64_t word;
+                std::memcpy(&word, entry_ptr + word_pos, sizeof(word));
+                if (word_pos < DIRENT64_NAME_OFFSET) { word |= ~(~std::uint64_t{} << ((DIRENT64_NAME_OFFSET - word_pos) * 8)); }
+                const auto zero_mask{ (word - 0x0101010101010101) & ~word & 0x8080808080808080 };
+                name_end = word_pos + static_cast<std::size_t>(std::countr_zero(zero_mask) / 8);
+            }
+            else
+            {
+                name_end = DIRENT64_NAME_OFFSET + std::strlen(reinterpret_cast<const char*>(entry_ptr + DIRENT64_NAME_OFFSET));
+            }
+
+            const auto name_bytes{ name_end - DIRENT64_NAME_OFFSET };
+            const auto name_ptr{ reinterpret_cast<const char*>(entry_ptr + DIRENT64_NAME_OFFSET) };
+            if (name_ptr[0] == '.' && (name_bytes == 1 || (name_bytes == 2 && name_ptr[1] == '.'))) { continue; } // skip . and ..
+
+            ZXFS_STAT_INC(EntrySeen);
+            m_pEntry = entry_ptr;
+            m_nNameBytes = name_bytes;
+            return true;
+        }
+    }
+
+    auto DirReader::GetFD() const -> int
+    {
+        return m_nFD;
+    }
+
+    auto DirReader::GetIno() const -> std::uint64_t
+    {
+        return reinterpret_cast<const linux_dirent64*>(m_pEntry)->d_ino;
+    }
+
+    auto DirReader::GetType() const -> std::uint8_t
+    {
+        return reinterpret_cast<const linux_dirent64*>(m_pEntry)->d_type;
+    }
+
+    auto DirReader::GetTypeResolved() const -> std::uint8_t
+    {
+        const auto type{ this->GetType() };
+        if (type != DT_UNKNOWN) { return type; }
+
+        struct stat st;
+        if (ZXFS_STAT_CALL(Stat, ::fstatat(m_nFD, reinterpret_cast<const char*>(m_pEntry + DIRENT64_NAME_OFFSET), &st, AT_SYMLINK_NOFOLLOW)) == -1) { return DT_UNKNOWN; }
+        return static_cast<std::uint8_t>(IFTODT(st.st_mode));
+    }
+
+    auto DirReader::GetName() const -> std::string_view
+    {
+        return { reinterpret_cast<const char*>(m_pEntry + DIRENT64_NAME_OFFSET), m_nNameBytes };
+    }
+
+    auto DirReader::GetOffset() const -> std::uint64_t
+    {
+        return static_cast<std::uint64_t>(reinterpret_cast<const linux_dirent64*>(m_pEntry)->d_off);
+    }
+
+    auto DirReader::IsFailed() const -> bool
+    {
+        return m_isFailed;
+    }
+
+    auto DirReader::Seek(const std::uint64_t nOffset) -> bool
+    {
+        m_nReadBytes = 0;
+        m_nReadPos = 0;
+        m_pEntry = nullptr;
+        m_isFailed = false;
+        return ::lseek(m_nFD, static_cast<off_t>(nOffset), SEEK_SET) != -1;
+    }
 } // namespace ZQF::Zut::ZxFS::Plat
 #endif
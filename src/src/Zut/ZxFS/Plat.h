@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
 #include <memory>
 #include <string_view>
 
@@ -11,10 +12,53 @@ namespace ZQF::Zut::ZxFS::Plat
     auto PathWideToUTF8(const std::wstring_view wsPath) -> std::pair<std::string_view, std::unique_ptr<char[]>>;
     auto PathUTF8ToWide(const std::string_view msPath, wchar_t* wpBuffer, const std::size_t nBufferChars) -> std::size_t;
     auto PathWideToUTF8(const std::wstring_view wsPath, char* cpBuffer, const std::size_t nBufferBytes) -> std::size_t;
+    auto FileReplaceDurable(const std::string_view msTempPath, const std::string_view msPath) -> bool; // see the linux declaration
 } // namespace ZQF::Zut::ZxFS::Plat
 #elif __linux__
 namespace ZQF::Zut::ZxFS::Plat
 {
     auto PathMaxBytes() -> std::size_t;
+    // flushes the written msTempPath to disk, renames it over msPath (replacing it) and flushes the parent directory, so a crash leaves either file whole
+    auto FileReplaceDurable(const std::string_view msTempPath, const std::string_view msPath) -> bool;
+
+    class DirReader
+    {
+    private:
+        int m_nFD{ -1 };
+        std::size_t m_nBufferBytes{};
+        std::size_t m_nReadBytes{};
+        std::size_t m_nReadPos{};
+        std::unique_ptr<std::byte[]> m_upBuffer;
+        const std::byte* m_pEntry{};
+        std::size_t m_nNameBytes{};
+        bool m_isFailed{};
+
+    public:
+        static constexpr std::size_t DEFAULT_BUFFER_BYTES{ 0x8000 };
+
+    public:
+        DirReader(const std::size_t nBufferBytes = DEFAULT_BUFFER_BYTES);
+        DirReader(const DirReader&) = delete;
+        auto operator=(const DirReader&) -> DirReader& = delete;
+        ~DirReader();
+
+    public:
+        auto Open(const char* cpPath) -> bool;
+        auto Open(const int nDirFD, const char* cpName) -> bool;
+        auto Attach(const int nDirFD) -> void;
+        auto Detach() -> int;
+        auto Close() -> bool;
+
+    public:
+        auto Next() -> bool; // skip . and ..
+        auto IsFailed() const -> bool; // the last Next() stopped on a getdents64 error, not at the end of the directory
+        auto GetFD() const -> int;
+        auto GetIno() const -> std::uint64_t;
+        auto GetType() const -> std::uint8_t;
+        auto GetTypeResolved() const -> std::uint8_t; // d_type, or one fstatat when the filesystem reports DT_UNKNOWN
+        auto GetName() const -> std::string_view; // null-terminated, valid until next Next()
+        auto GetOffset() const -> std::uint64_t; // d_off of the current entry, Seek to it continues after the entry
+        auto Seek(const std::uint64_t nOffset) -> bool;
+    };
 } // namespace ZQF::Zut::ZxFS::Plat
 #endif
@@ -0,0 +1,72 @@
+#include "Pool.h"
+#include <algorithm>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    Pool::Pool(const std::size_t nThreads)
+    {
+        const auto thread_count{ Pool::ThreadCount(nThreads) };
+        m_vcThreads.reserve(thread_count);
+
+        for (std::size_t index{}; index < thread_count; index++)
+        {
+            m_vcThreads.emplace_back([this]
+            {
+                while (true)
+                {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock lock{ m_mtxTasks };
+                        m_cvTasks.wait(lock, [this] { return m_isStop || !m_dqTasks.empty(); });
+                        if (m_dqTasks.empty()) { return; }
+                        task = std::move(m_dqTasks.front()); m_dqTasks.pop_front();
+                        m_nActiveTasks++;
+                    }
+
+                    task();
+
+                    {
+                        std::scoped_lock lock{ m_mtxTasks };
+                        m_nActiveTasks--;
+                        if (m_nActiveTasks == 0 && m_dqTasks.empty()) { m_cvIdle.notify_all(); }
+                    }
+                }
+            });
+        }
+    }
+
+    Pool::~Pool()
+    {
+        {
+            std::scoped_lock lock{ m_mtxTasks };
+            m_isStop = true;
+        }
+        m_cvTasks.notify_all();
+    }
+
+    auto Pool::Submit(std::function<void()> fnTask) -> void
+    {
+        {
+            std::scoped_lock lock{ m_mtxTasks };
+            m_dqTasks.emplace_back(std::move(fnTask));
+        }
+        m_cvTasks.notify_one();
+    }
+
+    auto Pool::Wait() -> void
+    {
+        std::unique_lock lock{ m_mtxTasks };
+        m_cvIdle.wait(lock, [this] { return m_nActiveTasks == 0 && m_dqTasks.empty(); });
+    }
+
+    auto Pool::GetThreadCount() const -> std::size_t
+    {
+        return m_vcThreads.size();
+    }
+
+    auto Pool::ThreadCount(const std::size_t nThreads) -> std::size_t
+    {
+        return nThreads != 0 ? nThreads : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,38 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // bounded worker pool, tasks may submit further tasks.
+    class Pool
+    {
+    private:
+        std::mutex m_mtxTasks;
+        std::condition_variable m_cvTasks;
+        std::condition_variable m_cvIdle;
+        std::deque<std::function<void()>> m_dqTasks;
+        std::size_t m_nActiveTasks{};
+        bool m_isStop{};
+        std::vector<std::jthread> m_vcThreads;
+
+    public:
+        Pool(const std::size_t nThreads);
+        Pool(const Pool&) = delete;
+        auto operator=(const Pool&) -> Pool& = delete;
+        ~Pool();
+
+    public:
+        auto Submit(std::function<void()> fnTask) -> void;
+        auto Wait() -> void;
+        auto GetThreadCount() const -> std::size_t;
+
+    public:
+        static auto ThreadCount(const std::size_t nThreads) -> std::size_t; // 0 -> std::thread::hardware_concurrency()
+    };
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,70 @@
+#pragma once
+#include <Zut/ZxFS/Stats.h>
+
+
+// internal counting hooks for Stats. without ZXFS_STATS they expand to nothing, arguments are not evaluated,
+// ZXFS_STAT_CALL(COUNTER, call) to just the call.
+#ifdef ZXFS_STATS
+#include <array>
+#include <atomic>
+#include <chrono>
+
+
+namespace ZQF::Zut::ZxFS::Probe
+{
+    // written by its owning thread only (plain load + store), read by Stats::Snapshot from any thread
+    struct ThreadBlock
+    {
+        std::array<std::atomic<std::uint64_t>, StatCounter::Count> Counters{};
+        std::array<std::atomic<std::uint64_t>, StatCounter::Count> CallNS{};
+        std::array<std::atomic<std::uint64_t>, StatPhase::Count> PhaseNS{};
+
+        ThreadBlock();
+        ThreadBlock(const ThreadBlock&) = delete;
+        auto operator=(const ThreadBlock&) -> ThreadBlock& = delete;
+        ~ThreadBlock();
+    };
+
+    auto Local() -> ThreadBlock&;
+
+    inline auto Bump(std::atomic<std::uint64_t>& rfValue, const std::uint64_t nDelta) -> void
+    {
+        rfValue.store(rfValue.load(std::memory_order_relaxed) + nDelta, std::memory_order_relaxed);
+    }
+
+    class PhaseTimer
+    {
+    private:
+        std::size_t m_nPhase{};
+        std::chrono::steady_clock::time_point m_tpBeg{ std::chrono::steady_clock::now() };
+
+    public:
+        PhaseTimer(const std::size_t nPhase) : m_nPhase{ nPhase } {}
+        PhaseTimer(const PhaseTimer&) = delete;
+        auto operator=(const PhaseTimer&) -> PhaseTimer& = delete;
+        ~PhaseTimer() { Probe::Bump(Probe::Local().PhaseNS[m_nPhase], static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_tpBeg).count())); }
+    };
+
+    // counts fnCall under nCounter and adds the time spent in it, errno is left as the call set it
+    template <typename FnCall>
+    inline auto TimedCall(const std::size_t nCounter, const FnCall& fnCall) -> decltype(fnCall())
+    {
+        auto& block{ Probe::Local() };
+        Probe::Bump(block.Counters[nCounter], 1);
+        const auto beg{ std::chrono::steady_clock::now() };
+        const auto result{ fnCall() };
+        Probe::Bump(block.CallNS[nCounter], static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - beg).count()));
+        return result;
+    }
+} // namespace ZQF::Zut::ZxFS::Probe
+
+#define ZXFS_STAT_CALL(COUNTER, ...) ::ZQF::Zut::ZxFS::Probe::TimedCall(::ZQF::Zut::ZxFS::StatCounter::COUNTER, [&] { return __VA_ARGS__; })
+#define ZXFS_STAT_ADD(COUNTER, DELTA) ::ZQF::Zut::ZxFS::Probe::Bump(::ZQF::Zut::ZxFS::Probe::Local().Counters[::ZQF::Zut::ZxFS::StatCounter::COUNTER], static_cast<std::uint64_t>(DELTA))
+#define ZXFS_STAT_PHASE(PHASE) const ::ZQF::Zut::ZxFS::Probe::PhaseTimer zxfs_stat_phase_timer{ ::ZQF::Zut::ZxFS::StatPhase::PHASE }
+#else
+#define ZXFS_STAT_CALL(COUNTER, ...) (__VA_ARGS__)
+#define ZXFS_STAT_ADD(COUNTER, DELTA) ((void)0)
+#define ZXFS_STAT_PHASE(PHASE) ((void)0)
+#endif
+
+#define ZXFS_STAT_INC(COUNTER) ZXFS_STAT_ADD(COUNTER, 1)
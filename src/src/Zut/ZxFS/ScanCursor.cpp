@@ -0,0 +1,297 @@
+#include "ScanCursor.h"
+#include "Plat.h"
+#include "Serial.h"
+#include <memory>
+#include <cstring>
+#include <utility>
+
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    struct CursorFind
+    {
+        HANDLE Handle{ INVALID_HANDLE_VALUE };
+        WIN32_FIND_DATAW FindData;
+        bool IsFindDataPending{}; // FindFirstFileExW already returned the next entry
+        char NameBuffer[MAX_PATH * 3];
+    };
+
+    static auto CursorAdvance(CursorFind& rfFind) -> bool
+    {
+        if (rfFind.IsFindDataPending) { rfFind.IsFindDataPending = false; return true; }
+        return ::FindNextFileW(rfFind.Handle, &rfFind.FindData) != FALSE;
+    }
+
+    // nPos counts every entry FindFirstFileExW / FindNextFileW returned so far, . and .. included
+    static auto CursorOpen(const std::string& msDirPath, const std::uint64_t nPos) -> std::uintptr_t
+    {
+        auto find{ std::make_unique<CursorFind>() };
+        const auto [search_path, search_path_buffer] = Plat::PathUTF8ToWide(std::string{ msDirPath }.append(1, '*'));
+        find->Handle = ::FindFirstFileExW(search_path_buffer.get(), FindExInfoBasic, &find->FindData, FindExSearchNameMatch, nullptr, 0);
+        if (find->Handle == INVALID_HANDLE_VALUE) { return 0; }
+        find->IsFindDataPending = true;
+
+        for (std::uint64_t pos{}; pos < nPos; pos++)
+        {
+            if (ZxFS::CursorAdvance(*find) == false) { break; }
+        }
+
+        return reinterpret_cast<std::uintptr_t>(find.release());
+    }
+
+    static auto CursorClose(const std::uintptr_t hFind) -> void
+    {
+        const auto find_ptr{ reinterpret_cast<CursorFind*>(hFind) };
+        ::FindClose(find_ptr->Handle);
+        delete find_ptr;
+    }
+
+    static auto CursorRead(const std::uintptr_t hFind, std::string_view& msName, bool& isDir, std::uint64_t& nPos) -> bool
+    {
+        auto& find{ *reinterpret_cast<CursorFind*>(hFind) };
+        while (ZxFS::CursorAdvance(find))
+        {
+            nPos++;
+            if ((*reinterpret_cast<std::uint32_t*>(find.FindData.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
+            if (((*reinterpret_cast<std::uint64_t*>(find.FindData.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+
+            const auto name_bytes{ Plat::PathWideToUTF8(find.FindData.cFileName, find.NameBuffer, sizeof(find.NameBuffer)) };
+            msName = { find.NameBuffer, name_bytes };
+            isDir = (find.FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            return true;
+        }
+
+        return false;
+    }
+} // namespace ZQF::Zut::ZxFS
+#elif __linux__
+#include <dirent.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // nPos is the d_off cookie of the last entry taken, 0 is the start of the directory
+    static auto CursorOpen(const std::string& msDirPath, const std::uint64_t nPos) -> std::uintptr_t
+    {
+        auto dir_reader{ std::make_unique<Plat::DirReader>() };
+        if (dir_reader->Open(msDirPath.c_str()) == false) { return 0; }
+        if ((nPos != 0) && (dir_reader->Seek(nPos) == false)) { return 0; }
+        return reinterpret_cast<std::uintptr_t>(dir_reader.release());
+    }
+
+    static auto CursorClose(const std::uintptr_t hFind) -> void
+    {
+        delete reinterpret_cast<Plat::DirReader*>(hFind);
+    }
+
+    static auto CursorRead(const std::uintptr_t hFind, std::string_view& msName, bool& isDir, std::uint64_t& nPos) -> bool
+    {
+        const auto dir_reader{ reinterpret_cast<Plat::DirReader*>(hFind) };
+        if (dir_reader->Next() == false) { return false; }
+
+        msName = dir_reader->GetName();
+        isDir = dir_reader->GetTypeResolved() == DT_DIR;
+        nPos = dir_reader->GetOffset();
+        return true;
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // cursor file layout (native endian):
+    //   magic[8] "ZXFSCUR1" | base dir | cur dir | u64 is cur dir | u64 cur pos | u64 pending count | pending dirs
+    constexpr char CURSOR_MAGIC[8]{ 'Z', 'X', 'F', 'S', 'C', 'U', 'R', '1' };
+
+    ScanCursor::ScanCursor(ScanCursor&& rfOther) noexcept
+        : m_msBaseDir{ std::move(rfOther.m_msBaseDir) }, m_msCurDir{ std::move(rfOther.m_msCurDir) }, m_nCurPos{ std::exchange(rfOther.m_nCurPos, 0) }, m_isCurDir{ std::exchange(rfOther.m_isCurDir, false) }, m_vcPendingDirs{ std::move(rfOther.m_vcPendingDirs) }, m_hFind{ std::exchange(rfOther.m_hFind, 0) }
+    {
+
+    }
+
+    auto ScanCursor::operator=(ScanCursor&& rfOther) noexcept -> ScanCursor&
+    {
+        if (this == &rfOther) { return *this; }
+        this->Clear();
+        m_msBaseDir = std::move(rfOther.m_msBaseDir);
+        m_msCurDir = std::move(rfOther.m_msCurDir);
+        m_nCurPos = std::exchange(rfOther.m_nCurPos, 0);
+        m_isCurDir = std::exchange(rfOther.m_isCurDir, false);
+        m_vcPendingDirs = std::move(rfOther.m_vcPendingDirs);
+        m_hFind = std::exchange(rfOther.m_hFind, 0);
+        return *this;
+    }
+
+    ScanCursor::~ScanCursor()
+    {
+        this->CloseDir();
+    }
+
+    auto ScanCursor::Start(const std::string_view msBaseDir) -> bool
+    {
+        this->Clear();
+        if (!msBaseDir.ends_with('/')) { return false; }
+
+        m_msBaseDir = msBaseDir;
+        m_isCurDir = true;
+        m_hFind = ZxFS::CursorOpen(m_msBaseDir, 0);
+        if (m_hFind == 0) { this->Clear(); return false; }
+
+        return true;
+    }
+
+    auto ScanCursor::Load(const std::string_view msCursorPath) -> bool
+    {
+        this->Clear();
+
+        std::ifstream ifs{ std::string{ msCursorPath }, std::ios::binary };
+        if (!ifs) { return false; }
+
+        char magic[sizeof(CURSOR_MAGIC)];
+        ifs.read(magic, sizeof(magic));
+        if (!ifs || std::memcmp(magic, CURSOR_MAGIC, sizeof(CURSOR_MAGIC)) != 0) { return false; }
+        if (ZxFS::ReadStr(ifs, m_msBaseDir) == false || ZxFS::ReadStr(ifs, m_msCurDir) == false) { this->Clear(); return false; }
+        m_isCurDir = ZxFS::ReadU64(ifs) != 0;
+        m_nCurPos = ZxFS::ReadU64(ifs);
+        if (ZxFS::ReadStrList(ifs, m_vcPendingDirs) == false) { this->Clear(); return false; }
+
+        if (!ifs || !m_msBaseDir.ends_with('/')) { this->Clear(); return false; }
+        return true; // the directory being read is reopened and seeked by the next Next()
+    }
+
+    auto ScanCursor::Save(const std::string_view msCursorPath) const -> bool
+    {
+        // write aside, flush and rename, a crash never leaves a half written cursor behind
+        const auto temp_path{ std::string{ msCursorPath }.append(".tmp") };
+        {
+            std::ofstream ofs{ temp_path, std::ios::binary | std::ios::trunc };
+            if (!ofs) { return false; }
+
+            ofs.write(CURSOR_MAGIC, sizeof(CURSOR_MAGIC));
+            ZxFS::WriteStr(ofs, m_msBaseDir);
+            ZxFS::WriteStr(ofs, m_msCurDir);
+            ZxFS::WriteU64(ofs, m_isCurDir ? 1 : 0);
+            ZxFS::WriteU64(ofs, m_nCurPos);
+            ZxFS::WriteU64(ofs, m_vcPendingDirs.size());
+            for (const auto& pending_dir : m_vcPendingDirs) { ZxFS::WriteStr(ofs, pending_dir); }
+
+            if (!ofs.flush()) { return false; }
+        }
+
+        return Plat::FileReplaceDurable(temp_path, msCursorPath);
+    }
+
+    auto ScanCursor::Clear() -> void
+    {
+        this->CloseDir();
+        m_msBaseDir.clear();
+        m_msCurDir.clear();
+        m_nCurPos = 0;
+        m_isCurDir = false;
+        m_vcPendingDirs.clear();
+    }
+
+    auto ScanCursor::CloseDir() -> void
+    {
+        if (m_hFind == 0) { return; }
+        ZxFS::CursorClose(m_hFind);
+        m_hFind = 0;
+    }
+
+    // the state is consistent after every single entry: a sub dir is pending, a file is appended, and m_nCurPos is past it
+    template <typename PathContainer>
+    auto ScanCursor::NextImp(PathContainer& vcPaths, const bool isWithDir, const std::size_t nMaxPaths) -> bool
+    {
+        std::string path_cache;
+        std::size_t prefix_bytes{};
+        bool is_prefix_stale{ true };
+        std::size_t path_count{};
+
+        while (path_count < nMaxPaths)
+        {
+            if (m_hFind == 0)
+            {
+                if (m_isCurDir == false)
+                {
+                    if (m_vcPendingDirs.empty()) { break; }
+                    m_msCurDir = std::move(m_vcPendingDirs.back()); m_vcPendingDirs.pop_back();
+                    m_nCurPos = 0;
+                    m_isCurDir = true;
+                }
+
+                m_hFind = ZxFS::CursorOpen(m_msBaseDir + m_msCurDir, m_nCurPos);
+                if (m_hFind == 0) { m_isCurDir = false; continue; }
+                is_prefix_stale = true;
+            }
+
+            std::string_view name;
+            bool is_dir{};
+            if (ZxFS::CursorRead(m_hFind, name, is_dir, m_nCurPos) == false) { this->CloseDir(); m_isCurDir = false; continue; }
+            if (is_dir) { m_vcPendingDirs.emplace_back(m_msCurDir).append(name).append(1, '/'); continue; }
+
+            if (is_prefix_stale)
+            {
+                path_cache.assign(isWithDir ? std::string_view{ m_msBaseDir } : std::string_view{}).append(m_msCurDir);
+                prefix_bytes = path_cache.size();
+                is_prefix_stale = false;
+            }
+            path_cache.resize(prefix_bytes);
+            path_cache.append(name);
+            vcPaths.emplace_back(path_cache);
+            path_count++;
+        }
+
+        return path_count != 0;
+    }
+
+    auto ScanCursor::Next(std::vector<std::string>& vcPaths, const bool isWithDir, const std::size_t nMaxPaths) -> bool
+    {
+        return this->NextImp(vcPaths, isWithDir, nMaxPaths);
+    }
+
+    auto ScanCursor::Next(PathList& vcPaths, const bool isWithDir, const std::size_t nMaxPaths) -> bool
+    {
+        return this->NextImp(vcPaths, isWithDir, nMaxPaths);
+    }
+
+    auto ScanCursor::Split(const std::size_t nParts) -> std::vector<ScanCursor>
+    {
+        std::vector<ScanCursor> cursors;
+        if (nParts < 2) { return cursors; }
+
+        std::vector<std::vector<std::string>> shares(nParts);
+        for (std::size_t index{}; index < m_vcPendingDirs.size(); index++) { shares[index % nParts].emplace_back(std::move(m_vcPendingDirs[index])); }
+        m_vcPendingDirs = std::move(shares.front());
+
+        for (std::size_t part{ 1 }; part < nParts; part++)
+        {
+            if (shares[part].empty()) { continue; }
+            auto& cursor{ cursors.emplace_back() };
+            cursor.m_msBaseDir = m_msBaseDir;
+            cursor.m_vcPendingDirs = std::move(shares[part]);
+        }
+
+        return cursors;
+    }
+
+    auto ScanCursor::IsDone() const -> bool
+    {
+        return (m_isCurDir == false) && m_vcPendingDirs.empty();
+    }
+
+    auto ScanCursor::GetBaseDir() const -> std::string_view
+    {
+        return m_msBaseDir;
+    }
+
+    auto ScanCursor::GetPendingDirCount() const -> std::size_t
+    {
+        return m_vcPendingDirs.size();
+    }
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <Zut/ZxFS/PathList.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // resumable recursive scan, reports everything but directories like GetFilePaths(msBaseDir, isWithDir, true).
+    // its whole state is the directory being read, how far it was read (the getdents64 d_off cookie on linux, the
+    // entry count on windows) and the directories still pending, so Save / Load continue it in another process.
+    // entries added to or removed from the directory being read in between may be missed or reported twice.
+    class ScanCursor
+    {
+    private:
+        std::string m_msBaseDir;
+        std::string m_msCurDir; // relative to the base dir, "" or "a/b/"
+        std::uint64_t m_nCurPos{};
+        bool m_isCurDir{};
+        std::vector<std::string> m_vcPendingDirs; // relative to the base dir, the last one is read next
+        std::uintptr_t m_hFind{};                 // reader of m_msCurDir, not part of the saved state
+
+    public:
+        ScanCursor() = default;
+        ScanCursor(const ScanCursor&) = delete;
+        ScanCursor(ScanCursor&& rfOther) noexcept;
+        auto operator=(const ScanCursor&) -> ScanCursor& = delete;
+        auto operator=(ScanCursor&& rfOther) noexcept -> ScanCursor&;
+        ~ScanCursor();
+
+    public:
+        auto Start(const std::string_view msBaseDir) -> bool;
+        auto Load(const std::string_view msCursorPath) -> bool;
+        auto Save(const std::string_view msCursorPath) const -> bool;
+        auto Clear() -> void;
+
+    public:
+        // appends up to nMaxPaths paths, false once the scan is finished and nothing was appended. unreadable directories are skipped.
+        auto Next(std::vector<std::string>& vcPaths, const bool isWithDir, const std::size_t nMaxPaths) -> bool;
+        auto Next(PathList& vcPaths, const bool isWithDir, const std::size_t nMaxPaths) -> bool;
+        // hands pending directories (whole subtrees) to up to nParts - 1 new cursors, this one keeps the directory being
+        // read and its own share. a fresh cursor has nothing pending yet, scan a little before splitting.
+        auto Split(const std::size_t nParts) -> std::vector<ScanCursor>;
+
+    public:
+        auto IsDone() const -> bool;
+        auto GetBaseDir() const -> std::string_view;
+        auto GetPendingDirCount() const -> std::size_t;
+
+    private:
+        template <typename PathContainer> auto NextImp(PathContainer& vcPaths, const bool isWithDir, const std::size_t nMaxPaths) -> bool;
+        auto CloseDir() -> void;
+    };
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,343 @@
+#include "ScanIndex.h"
+#include "Plat.h"
+#include "Serial.h"
+#include <chrono>
+#include <cstring>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // a directory touched within this window of the scan may still change inside the same timestamp tick,
+    // so its stamp is not trusted next time.
+    constexpr std::int64_t RACY_MTIME_NS{ 2'000'000'000 };
+
+    static auto NowNS() -> std::int64_t
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // puts the records already moved out of the index back, so a failed Update() leaves a usable index
+    static auto UpdateFailed(std::unordered_map<std::string, ScanIndex::DirRecord>& mpDirs, std::unordered_map<std::string, ScanIndex::DirRecord>& mpNewDirs) -> bool
+    {
+        for (auto& [dir_name, record] : mpNewDirs) { mpDirs.insert_or_assign(dir_name, std::move(record)); }
+        return false;
+    }
+
+    static auto IsStampEqual(const ScanIndex::DirRecord& rfRecord, const std::uint64_t nDev, const std::uint64_t nIno, const std::int64_t nMTime) -> bool
+    {
+        return (rfRecord.MTime != ScanIndex::DIRTY_MTIME) && (rfRecord.MTime == nMTime) && (rfRecord.Ino == nIno) && (rfRecord.Dev == nDev);
+    }
+} // namespace ZQF::Zut::ZxFS
+
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    static auto ReadDirRecord(const std::string& msDirPath, ScanIndex::DirRecord& rfRecord) -> bool
+    {
+        rfRecord.FileNames.clear();
+        rfRecord.SubDirNames.clear();
+
+        const auto [search_path, search_path_buffer] = Plat::PathUTF8ToWide(std::string{ msDirPath }.append(1, '*'));
+        WIN32_FIND_DATAW find_data;
+        const auto hfind = ::FindFirstFileExW(search_path_buffer.get(), FindExInfoBasic, &find_data, FindExSearchNameMatch, nullptr, 0);
+        if (hfind == INVALID_HANDLE_VALUE) { return false; }
+
+        do
+        {
+            if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
+            if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+
+            const auto [name, name_buffer] = Plat::PathWideToUTF8(find_data.cFileName);
+            ((find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ? rfRecord.SubDirNames : rfRecord.FileNames).emplace_back(name);
+        } while (::FindNextFileW(hfind, &find_data));
+
+        ::FindClose(hfind);
+        return true;
+    }
+
+    auto ScanIndex::Update(const std::string_view msBaseDir) -> bool
+    {
+        if (!msBaseDir.ends_with('/')) { return false; }
+        if (m_msBaseDir != msBaseDir) { this->Clear(); m_msBaseDir = msBaseDir; }
+
+        // any error but a vanished directory fails the update and keeps the old index,
+        // a skipped subtree would otherwise hide behind its parent's unchanged stamp.
+        const auto scan_beg_ns{ ZxFS::NowNS() };
+        std::unordered_map<std::string, DirRecord> new_dirs;
+        std::vector<std::string> dir_stack{ std::string{} };
+        std::size_t read_dir_count{};
+        std::size_t file_count{};
+        const auto is_vanished = [](const std::string& msDirName) { const auto error{ ::GetLastError() }; return !msDirName.empty() && (error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND); };
+
+        while (!dir_stack.empty())
+        {
+            auto dir_name{ std::move(dir_stack.back()) }; dir_stack.pop_back();
+            const auto dir_path{ std::string{ m_msBaseDir }.append(dir_name) };
+
+            // no inode on the find data path, the last write time of an ntfs directory moves with its entries
+            WIN32_FILE_ATTRIBUTE_DATA attr_data;
+            if (::GetFileAttributesExW(Plat::PathUTF8ToWide(dir_path).second.get(), GetFileExInfoStandard, &attr_data) == FALSE)
+            {
+                if (is_vanished(dir_name)) { continue; }
+                return ZxFS::UpdateFailed(m_mpDirs, new_dirs);
+            }
+
+            const auto write_time{ (static_cast<std::int64_t>(attr_data.ftLastWriteTime.dwHighDateTime) << 32) | attr_data.ftLastWriteTime.dwLowDateTime };
+            const auto mtime{ (write_time - 116444736000000000) * 100 };
+
+            DirRecord record;
+            const auto cached_ite{ m_mpDirs.find(dir_name) };
+            if ((cached_ite != m_mpDirs.end()) && ZxFS::IsStampEqual(cached_ite->second, 0, 0, mtime))
+            {
+                record = std::move(cached_ite->second);
+            }
+            else
+            {
+                if (ZxFS::ReadDirRecord(dir_path, record) == false) { if (is_vanished(dir_name)) { continue; } return ZxFS::UpdateFailed(m_mpDirs, new_dirs); }
+                record.MTime = mtime;
+                read_dir_count++;
+            }
+
+            if (record.MTime >= scan_beg_ns - RACY_MTIME_NS) { record.MTime = DIRTY_MTIME; }
+
+            for (const auto& sub_dir_name : record.SubDirNames) { dir_stack.emplace_back(std::string{ dir_name }.append(sub_dir_name).append(1, '/')); }
+            file_count += record.FileNames.size();
+            new_dirs.emplace(std::move(dir_name), std::move(record));
+        }
+
+        m_mpDirs = std::move(new_dirs);
+        m_nReadDirCount = read_dir_count;
+        m_nFileCount = file_count;
+        return true;
+    }
+} // namespace ZQF::Zut::ZxFS
+#elif __linux__
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    static auto ReadDirRecord(Plat::DirReader& rfDirReader, const int nDirFD, ScanIndex::DirRecord& rfRecord) -> bool
+    {
+        rfRecord.FileNames.clear();
+        rfRecord.SubDirNames.clear();
+
+        rfDirReader.Attach(nDirFD);
+        while (rfDirReader.Next())
+        {
+            (rfDirReader.GetTypeResolved() == DT_DIR ? rfRecord.SubDirNames : rfRecord.FileNames).emplace_back(rfDirReader.GetName());
+        }
+        const auto is_failed{ rfDirReader.IsFailed() };
+        rfDirReader.Detach();
+        return is_failed == false;
+    }
+
+    auto ScanIndex::Update(const std::string_view msBaseDir) -> bool
+    {
+        if (!msBaseDir.ends_with('/')) { return false; }
+        if (m_msBaseDir != msBaseDir) { this->Clear(); m_msBaseDir = msBaseDir; }
+
+        // the stamp of every directory comes from fstat on its open fd, unchanged directories are never read,
+        // only their cached sub directory names are followed. a directory is opened (relative to the base fd) when
+        // it is popped, so only two fds are open at any time. any error but a vanished directory fails the update
+        // and keeps the old index, a skipped subtree would otherwise hide behind its parent's unchanged stamp.
+        const auto scan_beg_ns{ ZxFS::NowNS() };
+        std::unordered_map<std::string, DirRecord> new_dirs;
+        std::vector<std::string> dir_stack{ std::string{} };
+        Plat::DirReader dir_reader;
+        std::size_t read_dir_count{};
+        std::size_t file_count{};
+
+        const auto base_dir_fd{ ::open(m_msBaseDir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+        if (base_dir_fd == -1) { return false; }
+
+        while (!dir_stack.empty())
+        {
+            auto dir_name{ std::move(dir_stack.back()) }; dir_stack.pop_back();
+
+            const auto dir_fd{ dir_name.empty() ? ::dup(base_dir_fd) : ::openat(base_dir_fd, dir_name.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+            if (dir_fd == -1)
+            {
+                if (!dir_name.empty() && (errno == ENOENT || errno == ENOTDIR)) { continue; } // vanished since it was listed
+                ::close(base_dir_fd);
+                return ZxFS::UpdateFailed(m_mpDirs, new_dirs);
+            }
+
+            struct stat st;
+            if (::fstat(dir_fd, &st) == -1) { ::close(dir_fd); ::close(base_dir_fd); return ZxFS::UpdateFailed(m_mpDirs, new_dirs); }
+            const auto mtime{ static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec };
+
+            DirRecord record;
+            const auto cached_ite{ m_mpDirs.find(dir_name) };
+            if ((cached_ite != m_mpDirs.end()) && ZxFS::IsStampEqual(cached_ite->second, st.st_dev, st.st_ino, mtime))
+            {
+                record = std::move(cached_ite->second);
+            }
+            else
+            {
+                if (ZxFS::ReadDirRecord(dir_reader, dir_fd, record) == false) { ::close(dir_fd); ::close(base_dir_fd); return ZxFS::UpdateFailed(m_mpDirs, new_dirs); }
+                record.Dev = st.st_dev;
+                record.Ino = st.st_ino;
+                record.MTime = mtime;
+                read_dir_count++;
+            }
+            ::close(dir_fd);
+
+            if (record.MTime >= scan_beg_ns - RACY_MTIME_NS) { record.MTime = DIRTY_MTIME; }
+
+            for (const auto& sub_dir_name : record.SubDirNames) { dir_stack.emplace_back(std::string{ dir_name }.append(sub_dir_name).append(1, '/')); }
+            file_count += record.FileNames.size();
+            new_dirs.emplace(std::move(dir_name), std::move(record));
+        }
+
+        ::close(base_dir_fd);
+        m_mpDirs = std::move(new_dirs);
+        m_nReadDirCount = read_dir_count;
+        m_nFileCount = file_count;
+        return true;
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // index file layout (native endian):
+    //   magic[8] "ZXFSIDX1" | u64 base dir bytes | base dir | u64 dir count
+    //   per dir: u64 name bytes | name | u64 dev | u64 ino | i64 mtime | u64 file count | files | u64 sub dir count | sub dirs
+    //   every string is a u64 byte count followed by its bytes.
+    constexpr char INDEX_MAGIC[8]{ 'Z', 'X', 'F', 'S', 'I', 'D', 'X', '1' };
+
+    auto ScanIndex::Load(const std::string_view msIndexPath) -> bool
+    {
+        this->Clear();
+
+        std::ifstream ifs{ std::string{ msIndexPath }, std::ios::binary };
+        if (!ifs) { return false; }
+
+        char magic[sizeof(INDEX_MAGIC)];
+        ifs.read(magic, sizeof(magic));
+        if (!ifs || std::memcmp(magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) { return false; }
+        if (ZxFS::ReadStr(ifs, m_msBaseDir) == false) { this->Clear(); return false; }
+
+        const auto dir_count{ ZxFS::ReadU64(ifs) };
+        for (std::uint64_t index{}; ifs && index < dir_count; index++)
+        {
+            std::string dir_name;
+            DirRecord record;
+            if (ZxFS::ReadStr(ifs, dir_name) == false) { this->Clear(); return false; }
+            record.Dev = ZxFS::ReadU64(ifs);
+            record.Ino = ZxFS::ReadU64(ifs);
+            record.MTime = static_cast<std::int64_t>(ZxFS::ReadU64(ifs));
+            if (ZxFS::ReadStrList(ifs, record.FileNames) == false || ZxFS::ReadStrList(ifs, record.SubDirNames) == false) { this->Clear(); return false; }
+            m_nFileCount += record.FileNames.size();
+            m_mpDirs.emplace(std::move(dir_name), std::move(record));
+        }
+
+        if (!ifs) { this->Clear(); return false; }
+        return true;
+    }
+
+    auto ScanIndex::Save(const std::string_view msIndexPath) const -> bool
+    {
+        // write aside, flush and rename, a crash never leaves a half written index behind
+        const auto temp_path{ std::string{ msIndexPath }.append(".tmp") };
+        {
+            std::ofstream ofs{ temp_path, std::ios::binary | std::ios::trunc };
+            if (!ofs) { return false; }
+
+            ofs.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+            ZxFS::WriteStr(ofs, m_msBaseDir);
+            ZxFS::WriteU64(ofs, m_mpDirs.size());
+            for (const auto& [dir_name, record] : m_mpDirs)
+            {
+                ZxFS::WriteStr(ofs, dir_name);
+                ZxFS::WriteU64(ofs, record.Dev);
+                ZxFS::WriteU64(ofs, record.Ino);
+                ZxFS::WriteU64(ofs, static_cast<std::uint64_t>(record.MTime));
+                ZxFS::WriteU64(ofs, record.FileNames.size());
+                for (const auto& file_name : record.FileNames) { ZxFS::WriteStr(ofs, file_name); }
+                ZxFS::WriteU64(ofs, record.SubDirNames.size());
+                for (const auto& sub_dir_name : record.SubDirNames) { ZxFS::WriteStr(ofs, sub_dir_name); }
+            }
+
+            if (!ofs.flush()) { return false; }
+        }
+
+        return Plat::FileReplaceDurable(temp_path, msIndexPath);
+    }
+
+    auto ScanIndex::Clear() -> void
+    {
+        m_msBaseDir.clear();
+        m_mpDirs.clear();
+        m_nFileCount = 0;
+        m_nReadDirCount = 0;
+    }
+
+    template <typename PathContainer>
+    static auto IndexFilePaths(PathContainer& vcPaths, const std::string_view msBaseDir, const std::unordered_map<std::string, ScanIndex::DirRecord>& mpDirs, const bool isWithDir) -> void
+    {
+        std::string path_cache{ isWithDir ? msBaseDir : std::string_view{} };
+        const auto prefix_bytes{ path_cache.size() };
+
+        for (const auto& [dir_name, record] : mpDirs)
+        {
+            path_cache.resize(prefix_bytes);
+            path_cache.append(dir_name);
+            const auto dir_path_bytes{ path_cache.size() };
+
+            for (const auto& file_name : record.FileNames)
+            {
+                path_cache.resize(dir_path_bytes);
+                path_cache.append(file_name);
+                vcPaths.emplace_back(std::string_view{ path_cache });
+            }
+        }
+    }
+
+    auto ScanIndex::GetFilePaths(std::vector<std::string>& vcPaths, const bool isWithDir) const -> void
+    {
+        vcPaths.reserve(vcPaths.size() + m_nFileCount);
+        ZxFS::IndexFilePaths(vcPaths, m_msBaseDir, m_mpDirs, isWithDir);
+    }
+
+    auto ScanIndex::GetFilePaths(PathList& vcPaths, const bool isWithDir) const -> void
+    {
+        ZxFS::IndexFilePaths(vcPaths, m_msBaseDir, m_mpDirs, isWithDir);
+    }
+
+    auto ScanIndex::GetBaseDir() const -> std::string_view
+    {
+        return m_msBaseDir;
+    }
+
+    auto ScanIndex::GetDirCount() const -> std::size_t
+    {
+        return m_mpDirs.size();
+    }
+
+    auto ScanIndex::GetFileCount() const -> std::size_t
+    {
+        return m_nFileCount;
+    }
+
+    auto ScanIndex::GetReadDirCount() const -> std::size_t
+    {
+        return m_nReadDirCount;
+    }
+
+    auto ScanIndex::Find(const std::string_view msDirPath) const -> const DirRecord*
+    {
+        const auto ite{ m_mpDirs.find(std::string{ msDirPath }) };
+        return ite != m_mpDirs.end() ? &ite->second : nullptr;
+    }
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <Zut/ZxFS/PathList.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // persistent directory listing cache. every directory is stored with its (dev, ino, mtime) stamp,
+    // Update() re-reads only directories whose stamp changed and reuses the cached listing for the rest.
+    class ScanIndex
+    {
+    public:
+        struct DirRecord
+        {
+            std::uint64_t Dev{};
+            std::uint64_t Ino{};
+            std::int64_t MTime{}; // ns, DIRTY_MTIME forces a re-read on the next Update()
+            std::vector<std::string> FileNames;
+            std::vector<std::string> SubDirNames;
+        };
+
+        static constexpr std::int64_t DIRTY_MTIME{ -1 };
+
+    private:
+        std::string m_msBaseDir;
+        std::unordered_map<std::string, DirRecord> m_mpDirs; // key: dir path relative to the base dir, "" or "a/b/"
+        std::size_t m_nFileCount{};
+        std::size_t m_nReadDirCount{};
+
+    public:
+        ScanIndex() = default;
+
+    public:
+        auto Load(const std::string_view msIndexPath) -> bool;
+        auto Save(const std::string_view msIndexPath) const -> bool;
+        auto Update(const std::string_view msBaseDir) -> bool;
+        auto Clear() -> void;
+
+    public:
+        auto GetFilePaths(std::vector<std::string>& vcPaths, const bool isWithDir) const -> void;
+        auto GetFilePaths(PathList& vcPaths, const bool isWithDir) const -> void;
+        auto GetBaseDir() const -> std::string_view;
+        auto GetDirCount() const -> std::size_t;
+        auto GetFileCount() const -> std::size_t;
+        auto GetReadDirCount() const -> std::size_t; // directories actually re-read by the last Update()
+        auto Find(const std::string_view msDirPath) const -> const DirRecord*;
+    };
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,47 @@
+#include "Scratch.h"
+#include <vector>
+#include <utility>
+
+
+namespace ZQF::Zut::ZxFS::Scratch
+{
+    constexpr std::size_t MAX_FREE_BUFFERS{ 8 };
+    constexpr std::size_t MAX_FREE_BUFFER_BYTES{ 0x10000 }; // a rare huge path is not kept around
+
+    struct FreeList
+    {
+        std::vector<std::string> Buffers;
+        ~FreeList();
+    };
+
+    // trivially destructible, stays readable while the thread's other thread_locals (and, on the main thread, statics) are destroyed
+    thread_local bool tls_is_free_list_gone{};
+    thread_local FreeList tls_free_list;
+
+    FreeList::~FreeList()
+    {
+        tls_is_free_list_gone = true;
+    }
+
+    auto Take() -> std::string
+    {
+        if (tls_is_free_list_gone || tls_free_list.Buffers.empty()) { return {}; }
+
+        auto buffer{ std::move(tls_free_list.Buffers.back()) };
+        tls_free_list.Buffers.pop_back();
+        buffer.clear();
+        return buffer;
+    }
+
+    auto Give(std::string&& msBuffer) -> void
+    {
+        if (tls_is_free_list_gone || (msBuffer.capacity() > MAX_FREE_BUFFER_BYTES) || (tls_free_list.Buffers.size() >= MAX_FREE_BUFFERS)) { return; }
+        tls_free_list.Buffers.emplace_back(std::move(msBuffer));
+    }
+
+    auto Fit(std::string& msBuffer, const std::size_t nBytes) -> char*
+    {
+        if (msBuffer.size() < nBytes) { msBuffer.resize_and_overwrite(nBytes, [](char*, const std::size_t nSize) { return nSize; }); }
+        return msBuffer.data();
+    }
+} // namespace ZQF::Zut::ZxFS::Scratch
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+
+namespace ZQF::Zut::ZxFS::Scratch
+{
+    // per-thread free list of path buffers. a buffer given back keeps its capacity, so the next Take on the
+    // same thread reuses it instead of allocating. buffers may be given back on any thread.
+    auto Take() -> std::string; // empty
+    auto Give(std::string&& msBuffer) -> void;
+    auto Fit(std::string& msBuffer, const std::size_t nBytes) -> char*; // at least nBytes long, bytes added are left unset
+
+    // a buffer of the free list for one scope
+    class PathBuffer
+    {
+    private:
+        std::string m_msBuffer{ Scratch::Take() };
+
+    public:
+        PathBuffer() = default;
+        PathBuffer(const std::size_t nBytes) { Scratch::Fit(m_msBuffer, nBytes); }
+        PathBuffer(const PathBuffer&) = delete;
+        auto operator=(const PathBuffer&) -> PathBuffer& = delete;
+        ~PathBuffer() { Scratch::Give(std::move(m_msBuffer)); }
+
+    public:
+        auto Get() -> std::string& { return m_msBuffer; }
+        template <typename T = char> auto Data() -> T* { return reinterpret_cast<T*>(m_msBuffer.data()); } // heap block, aligned for wchar_t
+    };
+} // namespace ZQF::Zut::ZxFS::Scratch
@@ -1,8 +1,74 @@
 #include "Searcher.h"
 #include "Plat.h"
+#include "Pool.h"
+#include "Probe.h"
+#include "Scratch.h"
 #include <stack>
+#include <deque>
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <iterator>
+#include <optional>
+#include <algorithm>
 #include <stdexcept>
+#include <functional>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // hands each path to the caller while it still sits in the scan's path buffer.
+    struct SearchVisitor
+    {
+        const std::function<bool(std::string_view)>& fnVisitor;
+    };
+
+    static auto EmplacePath(std::vector<std::string>& vcPaths, const char* cpPath, const std::size_t nBytes) -> bool
+    {
+        vcPaths.emplace_back(cpPath, nBytes);
+        return true;
+    }
+
+    static auto EmplacePath(PathList& vcPaths, const char* cpPath, const std::size_t nBytes) -> bool
+    {
+        vcPaths.emplace_back(cpPath, nBytes);
+        return true;
+    }
+
+    static auto EmplacePath(SearchVisitor& vcPaths, const char* cpPath, const std::size_t nBytes) -> bool
+    {
+        return vcPaths.fnVisitor(std::string_view{ cpPath, nBytes });
+    }
+
+    // like SearchVisitor, but also hands out the typed entry bound by BindEntry right before each EmplacePath.
+    struct SearchEntryVisitor
+    {
+        const std::function<bool(std::string_view, Entry&)>& fnVisitor;
+        std::uint32_t nStatFields{};
+        Entry CurEntry{};
+    };
+
+    static auto EmplacePath(SearchEntryVisitor& vcPaths, const char* cpPath, const std::size_t nBytes) -> bool
+    {
+        return vcPaths.fnVisitor(std::string_view{ cpPath, nBytes }, vcPaths.CurEntry);
+    }
+
+    // plain path containers do not keep entries
+    template <typename PathContainer, typename... Args>
+    static auto BindEntry(PathContainer& /* vcPaths */, const Args&... /* args */) -> void
+    {
+
+    }
+
+    // unfiltered policies never touch the filter
+    template <typename Policy>
+    static auto IsNameMatch(const Filter& rfFilter, const std::string_view msName) -> bool
+    {
+        if constexpr (Policy::IsFiltered) { return rfFilter.IsMatch(msName); }
+        else { return true; }
+    }
+} // namespace ZQF::Zut::ZxFS
 
 
 #ifdef _WIN32
@@ -14,54 +80,81 @@ namespace ZQF::Zut::ZxFS
 {
     constexpr auto PATH_MAX_BYTES = 0x1000;
 
-    static auto GetFilePathsCurDir(std::vector<std::string>& vcPaths, const std::string_view msBaseDir, const bool isWithDir) -> bool
+    static auto BindEntry(SearchEntryVisitor& vcPaths, const WIN32_FIND_DATAW& rfFindData, const std::string_view msName) -> void
+    {
+        const auto size{ (static_cast<std::uint64_t>(rfFindData.nFileSizeHigh) << 32) | rfFindData.nFileSizeLow };
+        const auto write_time{ (static_cast<std::uint64_t>(rfFindData.ftLastWriteTime.dwHighDateTime) << 32) | rfFindData.ftLastWriteTime.dwLowDateTime };
+        vcPaths.CurEntry.Bind(msName, rfFindData.dwFileAttributes, size, write_time);
+    }
+
+    // everything that is not a directory counts as File here
+    template <typename Policy>
+    static auto IsTypeAccept(const DWORD nAttributes) -> bool
+    {
+        if constexpr (Policy::AcceptTypes == SearchType::All) { return true; }
+        else if constexpr (Policy::AcceptTypes == SearchType::Dir) { return (nAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0; }
+        else { return (nAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0; }
+    }
+
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsCurDir(PathContainer& vcPaths, const std::string_view msBaseDir, const Filter& rfFilter) -> bool
     {
-        const auto u8path_cache = std::make_unique_for_overwrite<char[]>(PATH_MAX_BYTES);
+        Scratch::PathBuffer u8path_cache{ PATH_MAX_BYTES };
 
-        wchar_t* base_dir_ptr = reinterpret_cast<wchar_t*>(u8path_cache.get());
+        wchar_t* base_dir_ptr = u8path_cache.Data<wchar_t>();
         const auto base_dir_chars = Plat::PathUTF8ToWide(msBaseDir, base_dir_ptr, PATH_MAX_BYTES / sizeof(wchar_t));
         if (base_dir_chars == 0) { return false; }
         base_dir_ptr[base_dir_chars + 0] = L'*';
         base_dir_ptr[base_dir_chars + 1] = L'\0';
 
         WIN32_FIND_DATAW find_data;
-        const auto hfind = ::FindFirstFileExW(base_dir_ptr, FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0);
+        const auto hfind = ZXFS_STAT_CALL(OpenDir, ::FindFirstFileExW(base_dir_ptr, FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0));
         if (hfind == INVALID_HANDLE_VALUE) { return false; }
+        ZXFS_STAT_INC(DirVisited);
 
-        char* file_path_u8_ptr = u8path_cache.get();
-        const auto file_path_prefix_u8_bytes{ isWithDir ? (msBaseDir.size() * sizeof(char)) : 0 };
-        if (isWithDir) { std::memcpy(file_path_u8_ptr, msBaseDir.data(), file_path_prefix_u8_bytes); }
+        char* file_path_u8_ptr = u8path_cache.Data();
+        const auto file_path_prefix_u8_bytes{ Policy::IsWithDir ? (msBaseDir.size() * sizeof(char)) : 0 };
+        if constexpr (Policy::IsWithDir) { std::memcpy(file_path_u8_ptr, msBaseDir.data(), file_path_prefix_u8_bytes); }
 
-        const auto file_path_u8_remain_bytes = PATH_MAX_BYTES - file_path_prefix_u8_bytes;
+        const auto file_path_u8_remain_bytes = PATH_MAX_BYTES - file_path_prefix_u8_bytes - 1; // room for the trailing '/' of directories
 
         do
         {
             if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
             if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+            ZXFS_STAT_INC(EntrySeen);
 
-            if (!(find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+            if (IsTypeAccept<Policy>(find_data.dwFileAttributes) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+
+            const auto file_name_u8_bytes = Plat::PathWideToUTF8(find_data.cFileName, file_path_u8_ptr + file_path_prefix_u8_bytes, file_path_u8_remain_bytes);
+            if (IsNameMatch<Policy>(rfFilter, { file_path_u8_ptr + file_path_prefix_u8_bytes, file_name_u8_bytes }) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+            BindEntry(vcPaths, find_data, std::string_view{ file_path_u8_ptr + file_path_prefix_u8_bytes, file_name_u8_bytes });
+            auto file_path_u8_bytes = file_path_prefix_u8_bytes + file_name_u8_bytes;
+            if constexpr ((Policy::AcceptTypes & SearchType::Dir) != 0)
             {
-                const auto file_name_u8_bytes = Plat::PathWideToUTF8(find_data.cFileName, file_path_u8_ptr + file_path_prefix_u8_bytes, file_path_u8_remain_bytes);
-                const auto file_path_u8_bytes = file_path_prefix_u8_bytes + file_name_u8_bytes;
-                vcPaths.emplace_back(std::string{ file_path_u8_ptr, file_path_u8_bytes });
+                if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) { file_path_u8_ptr[file_path_u8_bytes++] = '/'; file_path_u8_ptr[file_path_u8_bytes] = '\0'; }
             }
+            if (EmplacePath(vcPaths, file_path_u8_ptr, file_path_u8_bytes) == false) { break; }
         } while (::FindNextFileW(hfind, &find_data));
 
+        ::FindClose(hfind);
+
         return true;
     }
 
-    static auto GetFilePathsRecursive(std::vector<std::string>& vcPaths, const std::string_view msBaseDir, const bool isWithDir) -> bool
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsRecursive(PathContainer& vcPaths, const std::string_view msBaseDir, const Filter& rfFilter) -> bool
     {
         std::stack<std::wstring> search_dir_stack;
         search_dir_stack.push(L"*");
 
-        const auto file_path_u8_cache = std::make_unique_for_overwrite<char[]>(PATH_MAX_BYTES);
-        char* file_path_u8_ptr = file_path_u8_cache.get();
-        const auto file_path_prefix_u8_bytes{ isWithDir ? (msBaseDir.size() * sizeof(char)) : 0 };
-        if (isWithDir) { std::memcpy(file_path_u8_ptr, msBaseDir.data(), file_path_prefix_u8_bytes); }
+        Scratch::PathBuffer file_path_u8_cache{ PATH_MAX_BYTES };
+        char* file_path_u8_ptr = file_path_u8_cache.Data();
+        const auto file_path_prefix_u8_bytes{ Policy::IsWithDir ? (msBaseDir.size() * sizeof(char)) : 0 };
+        if constexpr (Policy::IsWithDir) { std::memcpy(file_path_u8_ptr, msBaseDir.data(), file_path_prefix_u8_bytes); }
 
-        const auto cur_dir_cache = std::make_unique_for_overwrite<wchar_t[]>(PATH_MAX_BYTES / sizeof(wchar_t));
-        wchar_t* cur_dir_ptr = cur_dir_cache.get();
+        Scratch::PathBuffer cur_dir_cache{ PATH_MAX_BYTES };
+        wchar_t* cur_dir_ptr = cur_dir_cache.Data<wchar_t>();
         const auto base_dir_chars = Plat::PathUTF8ToWide(msBaseDir, cur_dir_ptr, PATH_MAX_BYTES / sizeof(wchar_t));
         if (base_dir_chars == 0) { return false; }
 
@@ -72,34 +165,54 @@ namespace ZQF::Zut::ZxFS
             cur_dir_ptr[base_dir_chars + search_dir_name.size()] = L'\0';
 
             WIN32_FIND_DATAW find_data;
-            const auto hfind = ::FindFirstFileExW(cur_dir_ptr, FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0);
+            const auto hfind = ZXFS_STAT_CALL(OpenDir, ::FindFirstFileExW(cur_dir_ptr, FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0));
             if (hfind == INVALID_HANDLE_VALUE) { return false; }
+            ZXFS_STAT_INC(DirVisited);
 
             const auto search_dir_name_u8_ptr = file_path_u8_ptr + file_path_prefix_u8_bytes;
             const auto search_dir_name_u8_bytes = Plat::PathWideToUTF8({ search_dir_name.data() ,search_dir_name.size() - 1 }, search_dir_name_u8_ptr, PATH_MAX_BYTES - file_path_prefix_u8_bytes);
 
             const auto file_path_with_dir_u8_bytes = file_path_prefix_u8_bytes + search_dir_name_u8_bytes;
             const auto file_name_u8_ptr = file_path_u8_ptr + file_path_with_dir_u8_bytes;
-            const auto file_path_u8_remain_bytes = PATH_MAX_BYTES - file_path_with_dir_u8_bytes;
+            const auto file_path_u8_remain_bytes = PATH_MAX_BYTES - file_path_with_dir_u8_bytes - 1; // room for the trailing '/' of directories
 
             do
             {
                 if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
                 if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+                ZXFS_STAT_INC(EntrySeen);
 
                 const auto file_name_chars = ::wcslen(find_data.cFileName);
 
                 if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
                 {
+                    if constexpr ((Policy::AcceptTypes & SearchType::Dir) != 0)
+                    {
+                        const auto dir_name_u8_bytes = Plat::PathWideToUTF8({ find_data.cFileName, file_name_chars }, file_name_u8_ptr, file_path_u8_remain_bytes);
+                        if (IsNameMatch<Policy>(rfFilter, { file_name_u8_ptr, dir_name_u8_bytes }))
+                        {
+                            BindEntry(vcPaths, find_data, std::string_view{ file_name_u8_ptr, dir_name_u8_bytes });
+                            file_name_u8_ptr[dir_name_u8_bytes + 0] = '/';
+                            file_name_u8_ptr[dir_name_u8_bytes + 1] = '\0';
+                            if (EmplacePath(vcPaths, file_path_u8_ptr, file_path_with_dir_u8_bytes + dir_name_u8_bytes + 1) == false) { ::FindClose(hfind); return true; }
+                        }
+                    }
+
                     find_data.cFileName[file_name_chars + 0] = L'/';
                     find_data.cFileName[file_name_chars + 1] = L'*'; // might override WIN32_FIND_DATAW::cAlternateFileName, but we never use it, so that's safe.
                     search_dir_stack.push(std::move(std::wstring{ search_dir_name.data(), search_dir_name.size() - 1 }.append(find_data.cFileName, file_name_chars + 2)));
                 }
-                else
+                else if (IsTypeAccept<Policy>(find_data.dwFileAttributes))
                 {
                     const auto file_name_u8_bytes = Plat::PathWideToUTF8({ find_data.cFileName, file_name_chars }, file_name_u8_ptr, file_path_u8_remain_bytes);
+                    if (IsNameMatch<Policy>(rfFilter, { file_name_u8_ptr, file_name_u8_bytes }) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+                    BindEntry(vcPaths, find_data, std::string_view{ file_name_u8_ptr, file_name_u8_bytes });
                     const auto file_path_u8_bytes = file_path_with_dir_u8_bytes + file_name_u8_bytes;
-                    vcPaths.emplace_back(std::string{ file_path_u8_ptr, file_path_u8_bytes });
+                    if (EmplacePath(vcPaths, file_path_u8_ptr, file_path_u8_bytes) == false) { ::FindClose(hfind); return true; }
+                }
+                else
+                {
+                    ZXFS_STAT_INC(EntrySkipped);
                 }
             } while (::FindNextFileW(hfind, &find_data));
 
@@ -110,121 +223,633 @@ namespace ZQF::Zut::ZxFS
         return true;
     }
 
-    auto Searcher::GetFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive) -> std::vector<std::string>
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsOneDir(PathContainer& vcPaths, std::vector<std::string>& vcSubDirs, std::string& msPathCache, const std::string_view msBaseDir, const std::string_view msDirName, const Filter& rfFilter) -> bool
     {
-        std::vector<std::string> file_path_list;
-        const auto status = Searcher::GetFilePaths(file_path_list, msSearchDir, isWithDir, isRecursive);
-        if (status == false) { throw std::runtime_error(std::string{ "ZxPath::Walk::GetFilePaths(): dir open error! -> " }.append(msSearchDir)); }
-        return file_path_list;
+        msPathCache.assign(msBaseDir).append(msDirName).append(1, '*');
+        const auto [search_dir_w, search_dir_w_buffer] = Plat::PathUTF8ToWide(msPathCache);
+        msPathCache.pop_back();
+
+        WIN32_FIND_DATAW find_data;
+        const auto hfind = ZXFS_STAT_CALL(OpenDir, ::FindFirstFileExW(search_dir_w_buffer.get(), FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, 0));
+        if (hfind == INVALID_HANDLE_VALUE) { return false; }
+        ZXFS_STAT_INC(DirVisited);
+
+        const auto file_path_offset{ Policy::IsWithDir ? 0 : msBaseDir.size() };
+        const auto dir_path_bytes{ msPathCache.size() };
+        char file_name_u8[PATH_MAX_BYTES];
+
+        do
+        {
+            if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
+            if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+            ZXFS_STAT_INC(EntrySeen);
+
+            const auto file_name_u8_bytes = Plat::PathWideToUTF8(find_data.cFileName, file_name_u8, PATH_MAX_BYTES);
+
+            if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                vcSubDirs.emplace_back(std::string{ msDirName }.append(file_name_u8, file_name_u8_bytes).append(1, '/'));
+
+                if constexpr ((Policy::AcceptTypes & SearchType::Dir) != 0)
+                {
+                    if (IsNameMatch<Policy>(rfFilter, { file_name_u8, file_name_u8_bytes }) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+                    msPathCache.resize(dir_path_bytes);
+                    msPathCache.append(file_name_u8, file_name_u8_bytes).append(1, '/');
+                    vcPaths.emplace_back(msPathCache.data() + file_path_offset, msPathCache.size() - file_path_offset);
+                }
+            }
+            else if (IsTypeAccept<Policy>(find_data.dwFileAttributes) && IsNameMatch<Policy>(rfFilter, { file_name_u8, file_name_u8_bytes }))
+            {
+                msPathCache.resize(dir_path_bytes);
+                msPathCache.append(file_name_u8, file_name_u8_bytes);
+                vcPaths.emplace_back(msPathCache.data() + file_path_offset, msPathCache.size() - file_path_offset);
+            }
+            else
+            {
+                ZXFS_STAT_INC(EntrySkipped);
+            }
+        } while (::FindNextFileW(hfind, &find_data));
+
+        ::FindClose(hfind);
+
+        return true;
     }
 
-    auto Searcher::GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive) -> bool
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsQueued(PathContainer& vcPaths, const std::string_view msBaseDir, const std::size_t /* nQueueDepth */) -> bool
     {
-        if (!msSearchDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxPath::Walk::GetFilePaths(): dir format error! -> " }.append(msSearchDir)); }
-        return isRecursive ? GetFilePathsRecursive(vcPaths, msSearchDir, isWithDir) : GetFilePathsCurDir(vcPaths, msSearchDir, isWithDir);
+        ZXFS_STAT_PHASE(Scan);
+        return GetFilePathsRecursive<Policy>(vcPaths, msBaseDir, Searcher::MatchAll);
     }
 } // namespace ZQF::Zut::ZxFS
 #elif __linux__
+#include "Uring.h"
+#include <unistd.h>
+#include <fcntl.h>
 #include <dirent.h>
+#include <sys/stat.h>
+#include <cerrno>
 #include <cstring>
 
 namespace ZQF::Zut::ZxFS
 {
-    static auto GetFilePathsCurDir(std::vector<std::string>& vcPaths, const std::string_view msBaseDir, const bool isWithDir) -> bool
+    static auto BindEntry(SearchEntryVisitor& vcPaths, const Plat::DirReader& rfDirReader, const std::uint8_t nType) -> void
     {
-        const auto dir_ptr{ ::opendir(msBaseDir.data()) };
-        if (dir_ptr == nullptr) { return false; }
+        vcPaths.CurEntry.Bind(rfDirReader.GetFD(), rfDirReader.GetName(), nType, rfDirReader.GetIno(), vcPaths.nStatFields);
+    }
 
-        auto entry_ptr{ ::readdir(dir_ptr) };
-        if (entry_ptr == nullptr) { return false; }
+    // nType is a resolved d_type, File means regular files only
+    template <typename Policy>
+    static auto IsTypeAccept(const std::uint8_t nType) -> bool
+    {
+        if constexpr (Policy::AcceptTypes == SearchType::All) { return true; }
+        else if constexpr (Policy::AcceptTypes == SearchType::NonDir) { return nType != DT_DIR; }
+        else if constexpr (Policy::AcceptTypes == SearchType::Dir) { return nType == DT_DIR; }
+        else { return nType == DT_REG; }
+    }
+
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsCurDir(PathContainer& vcPaths, const std::string_view msBaseDir, const Filter& rfFilter) -> bool
+    {
+        Plat::DirReader dir_reader;
+        if (dir_reader.Open(msBaseDir.data()) == false) { return false; }
 
-        if (isWithDir)
+        if constexpr (Policy::IsWithDir || (Policy::AcceptTypes & SearchType::Dir) != 0)
         {
             const auto path_max_bytes{ Plat::PathMaxBytes() };
-            const auto path_cache{ std::make_unique_for_overwrite<char[]>(path_max_bytes) };
-            auto file_path_ptr{ path_cache.get() };
+            Scratch::PathBuffer path_cache{ path_max_bytes };
+            const auto file_path_ptr{ path_cache.Data() };
+            const auto file_name_offset{ Policy::IsWithDir ? msBaseDir.size() : 0 };
 
-            std::memcpy(file_path_ptr, msBaseDir.data(), msBaseDir.size());
+            if constexpr (Policy::IsWithDir) { std::memcpy(file_path_ptr, msBaseDir.data(), msBaseDir.size()); }
 
-            do
+            while (dir_reader.Next())
             {
-                if ((*reinterpret_cast<std::uint16_t*>(entry_ptr->d_name)) == std::uint32_t(0x002E)) { continue; }// skip .
-                if (((*reinterpret_cast<std::uint32_t*>(entry_ptr->d_name)) & 0x00FFFFFF) == std::uint32_t(0x00002E2E)) { continue; }// skip ..
-                if (entry_ptr->d_type != DT_REG) { continue; }
-
-                const auto file_name_bytes{ std::strlen(entry_ptr->d_name) };
-                std::memcpy(file_path_ptr + msBaseDir.size(), entry_ptr->d_name, file_name_bytes);
-                const auto file_path_bytes{ msBaseDir.size() + file_name_bytes };
-                vcPaths.emplace_back(file_path_ptr, file_path_bytes);
-            } while ((entry_ptr = ::readdir(dir_ptr)) != nullptr);
+                const auto entry_type{ dir_reader.GetTypeResolved() };
+                if (IsTypeAccept<Policy>(entry_type) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+
+                const auto entry_name{ dir_reader.GetName() };
+                if (IsNameMatch<Policy>(rfFilter, entry_name) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+                const auto is_dir{ (Policy::AcceptTypes & SearchType::Dir) != 0 && entry_type == DT_DIR };
+                const auto entry_path_bytes{ file_name_offset + entry_name.size() + (is_dir ? 1 : 0) };
+                if (entry_path_bytes >= path_max_bytes) { continue; }
+                std::memcpy(file_path_ptr + file_name_offset, entry_name.data(), entry_name.size());
+                if (is_dir) { file_path_ptr[entry_path_bytes - 1] = '/'; }
+                file_path_ptr[entry_path_bytes] = '\0';
+                BindEntry(vcPaths, dir_reader, entry_type);
+                if (EmplacePath(vcPaths, file_path_ptr, entry_path_bytes) == false) { break; }
+            }
         }
         else
         {
-            do
+            // bare file names are emitted straight from the getdents64 buffer
+            while (dir_reader.Next())
             {
-                if ((*reinterpret_cast<std::uint16_t*>(entry_ptr->d_name)) == std::uint32_t(0x002E)) { continue; }// skip .
-                if (((*reinterpret_cast<std::uint32_t*>(entry_ptr->d_name)) & 0x00FFFFFF) == std::uint32_t(0x00002E2E)) { continue; }// skip ..
-                if (entry_ptr->d_type != DT_REG) { continue; }
-                vcPaths.emplace_back(entry_ptr->d_name);
-            } while ((entry_ptr = ::readdir(dir_ptr)) != nullptr);
+                const auto entry_type{ dir_reader.GetTypeResolved() };
+                if (IsTypeAccept<Policy>(entry_type) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+                const auto file_name{ dir_reader.GetName() };
+                if (IsNameMatch<Policy>(rfFilter, file_name) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+                BindEntry(vcPaths, dir_reader, entry_type);
+                if (EmplacePath(vcPaths, file_name.data(), file_name.size()) == false) { break; }
+            }
         }
 
-        const auto status{ ::closedir(dir_ptr) };
-        return status != (-1) ? true : false;
+        return dir_reader.Close();
     }
 
-    static auto GetFilePathsRecursive(std::vector<std::string>& vcPaths, const std::string_view msBaseDir, const bool isWithDir) -> bool
+    struct SearchDirFrame
     {
-        std::stack<std::string> search_dir_stack;
-        search_dir_stack.push("");
+        int DirFD{ -1 };
+        std::size_t DirPathBytes{};
+        std::vector<std::string> SubDirNames{};
+    };
 
-        const auto path_max_bytes{ Plat::PathMaxBytes() };
-        const auto file_path_cache{ std::make_unique_for_overwrite<char[]>(path_max_bytes) };
-        std::memcpy(file_path_cache.get(), msBaseDir.data(), msBaseDir.size() * sizeof(char));
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsRecursive(PathContainer& vcPaths, const std::string_view msBaseDir, const Filter& rfFilter) -> bool
+    {
+        // every sub directory is opened relative to its parent fd, so the kernel never re-walks the path prefix.
+        // only the fds along the current branch stay open.
+        std::vector<SearchDirFrame> search_dir_frames;
+        Scratch::PathBuffer file_path_lease;
+        auto& file_path_cache{ file_path_lease.Get().append(msBaseDir) };
+        const auto file_path_offset{ Policy::IsWithDir ? 0 : msBaseDir.size() };
 
-        const auto search_dir_path_ptr{ file_path_cache.get() };
+        Plat::DirReader dir_reader;
 
-        const auto file_path_ptr{ isWithDir ? search_dir_path_ptr : search_dir_path_ptr + msBaseDir.size() };
-        const auto file_path_prefix_bytes{ isWithDir ? msBaseDir.size() : 0 };
+        const auto read_dir = [&](const int nDirFD) -> bool
+        {
+            auto& frame{ search_dir_frames.emplace_back(nDirFD, file_path_cache.size()) };
 
-        do
+            dir_reader.Attach(nDirFD);
+            while (dir_reader.Next())
+            {
+                const auto entry_name{ dir_reader.GetName() };
+                const auto entry_type{ dir_reader.GetTypeResolved() };
+
+                if (entry_type == DT_DIR)
+                {
+                    frame.SubDirNames.emplace_back(entry_name);
+
+                    if constexpr ((Policy::AcceptTypes & SearchType::Dir) != 0)
+                    {
+                        if (IsNameMatch<Policy>(rfFilter, entry_name) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+                        file_path_cache.resize(frame.DirPathBytes);
+                        file_path_cache.append(entry_name).append(1, '/');
+                        BindEntry(vcPaths, dir_reader, entry_type);
+                        if (EmplacePath(vcPaths, file_path_cache.data() + file_path_offset, file_path_cache.size() - file_path_offset) == false) { dir_reader.Detach(); return false; }
+                    }
+                }
+                else if (IsTypeAccept<Policy>(entry_type) && IsNameMatch<Policy>(rfFilter, entry_name))
+                {
+                    file_path_cache.resize(frame.DirPathBytes);
+                    file_path_cache.append(entry_name);
+                    BindEntry(vcPaths, dir_reader, entry_type);
+                    if (EmplacePath(vcPaths, file_path_cache.data() + file_path_offset, file_path_cache.size() - file_path_offset) == false) { dir_reader.Detach(); return false; }
+                }
+                else
+                {
+                    ZXFS_STAT_INC(EntrySkipped);
+                }
+            }
+            dir_reader.Detach();
+            return true;
+        };
+
+        const auto close_frames = [&]
         {
-            const auto search_dir_name{ std::move(search_dir_stack.top()) }; search_dir_stack.pop();
+            for (const auto& opened_frame : search_dir_frames) { ::close(opened_frame.DirFD); }
+        };
+
+        const auto base_dir_fd{ ZXFS_STAT_CALL(OpenDir, ::open(msBaseDir.data(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)) };
+        if (base_dir_fd == -1) { return false; }
+        if (read_dir(base_dir_fd) == false) { close_frames(); return true; }
+
+        while (!search_dir_frames.empty())
+        {
+            auto& frame{ search_dir_frames.back() };
 
-            std::memcpy(search_dir_path_ptr + msBaseDir.size(), search_dir_name.data(), search_dir_name.size() * sizeof(char));
-            search_dir_path_ptr[msBaseDir.size() + search_dir_name.size()] = {};
+            if (frame.SubDirNames.empty())
+            {
+                ::close(frame.DirFD);
+                search_dir_frames.pop_back();
+                continue;
+            }
 
-            const auto dir_ptr{ ::opendir(search_dir_path_ptr) };
-            if (dir_ptr == nullptr) { return false; }
+            const auto sub_dir_name{ std::move(frame.SubDirNames.back()) }; frame.SubDirNames.pop_back();
+            const auto sub_dir_fd{ ZXFS_STAT_CALL(OpenDir, ::openat(frame.DirFD, sub_dir_name.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)) };
+            if (sub_dir_fd == -1) { close_frames(); return false; }
 
-            auto entry_ptr{ ::readdir(dir_ptr) };
-            if (entry_ptr == nullptr) { return false; }
+            file_path_cache.resize(frame.DirPathBytes);
+            file_path_cache.append(sub_dir_name).append(1, '/');
+            if (read_dir(sub_dir_fd) == false) { close_frames(); return true; }
+        }
 
-            do
+        return true;
+    }
+
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsOneDir(PathContainer& vcPaths, std::vector<std::string>& vcSubDirs, std::string& msPathCache, const std::string_view msBaseDir, const std::string_view msDirName, const Filter& rfFilter) -> bool
+    {
+        msPathCache.assign(msBaseDir).append(msDirName);
+
+        thread_local Plat::DirReader dir_reader;
+        if (dir_reader.Open(msPathCache.c_str()) == false) { return false; }
+
+        const auto file_path_offset{ Policy::IsWithDir ? 0 : msBaseDir.size() };
+        const auto dir_path_bytes{ msPathCache.size() };
+
+        while (dir_reader.Next())
+        {
+            const auto entry_name{ dir_reader.GetName() };
+            const auto entry_type{ dir_reader.GetTypeResolved() };
+
+            if (entry_type == DT_DIR)
+            {
+                vcSubDirs.emplace_back(std::string{ msDirName }.append(entry_name).append(1, '/'));
+
+                if constexpr ((Policy::AcceptTypes & SearchType::Dir) != 0)
+                {
+                    if (IsNameMatch<Policy>(rfFilter, entry_name) == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+                    msPathCache.resize(dir_path_bytes);
+                    msPathCache.append(entry_name).append(1, '/');
+                    vcPaths.emplace_back(msPathCache.data() + file_path_offset, msPathCache.size() - file_path_offset);
+                }
+            }
+            else if (IsTypeAccept<Policy>(entry_type) && IsNameMatch<Policy>(rfFilter, entry_name))
+            {
+                msPathCache.resize(dir_path_bytes);
+                msPathCache.append(entry_name);
+                vcPaths.emplace_back(msPathCache.data() + file_path_offset, msPathCache.size() - file_path_offset);
+            }
+            else
+            {
+                ZXFS_STAT_INC(EntrySkipped);
+            }
+        }
+
+        return dir_reader.Close();
+    }
+
+    struct UringDirOp
+    {
+        std::string DirName{};
+        std::string DirPath{};
+        int DirFD{ -1 };
+
+        UringDirOp(std::string&& msDirName) : DirName{ std::move(msDirName) } {}
+        UringDirOp(const UringDirOp&) = delete;
+        auto operator=(const UringDirOp&) -> UringDirOp& = delete;
+        ~UringDirOp() { if (DirFD != -1) { ::close(DirFD); } }
+    };
+
+    struct UringStatxOp
+    {
+        std::shared_ptr<UringDirOp> spDirOp{}; // keeps the dir fd open until its last statx completes
+        std::string EntryName{};
+        struct statx Statx{};
+    };
+
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsQueued(PathContainer& vcPaths, const std::string_view msBaseDir, const std::size_t nQueueDepth) -> bool
+    {
+        ZXFS_STAT_PHASE(Scan);
+        static_assert(Policy::IsRecursive && Policy::AcceptTypes == SearchType::NonDir && !Policy::IsFiltered, "GetFilePathsQueued: recursive, unfiltered non-directory scans only");
+
+        // no ring, or a kernel (< 5.6) without the openat/statx ops: the synchronous walk does the same job
+        Plat::Uring uring;
+        if ((uring.Init(static_cast<unsigned>(std::clamp<std::size_t>(nQueueDepth, 1, 4096))) == false) || (uring.IsOpSupported(IORING_OP_OPENAT) == false) || (uring.IsOpSupported(IORING_OP_STATX) == false))
+        {
+            return GetFilePathsRecursive<Policy>(vcPaths, msBaseDir, Searcher::MatchAll);
+        }
+
+        // directory opens and statx of DT_UNKNOWN entries are kept in flight, getdents64 runs on completion.
+        // user_data is the op pointer, bit 0 tags statx ops. an op in flight is owned by the ring and taken back
+        // into a unique_ptr by its completion, so a failed submit drains the ring instead of returning early.
+        const auto queue_depth{ static_cast<std::size_t>(uring.GetEntries()) };
+        std::vector<std::string> open_wait_list{ std::string{} };
+        std::deque<std::unique_ptr<UringStatxOp>> statx_wait_list;
+        std::size_t inflight_count{};
+        bool is_failed{};
+        bool is_draining{};
+
+        Plat::DirReader dir_reader;
+        Scratch::PathBuffer file_path_lease;
+        auto& file_path_cache{ file_path_lease.Get().append(msBaseDir) };
+        const auto file_path_offset{ Policy::IsWithDir ? 0 : msBaseDir.size() };
+
+        const auto emplace_file_path = [&](const std::string_view msDirName, const std::string_view msFileName)
+        {
+            file_path_cache.resize(msBaseDir.size());
+            file_path_cache.append(msDirName).append(msFileName);
+            vcPaths.emplace_back(file_path_cache.data() + file_path_offset, file_path_cache.size() - file_path_offset);
+        };
+
+        while (true)
+        {
+            while (!is_draining && inflight_count < queue_depth && (!statx_wait_list.empty() || (!is_failed && !open_wait_list.empty())))
             {
-                if ((*reinterpret_cast<std::uint16_t*>(entry_ptr->d_name)) == std::uint32_t(0x002E)) { continue; }// skip .
-                if (((*reinterpret_cast<std::uint32_t*>(entry_ptr->d_name)) & 0x00FFFFFF) == std::uint32_t(0x00002E2E)) { continue; }// skip ..
+                const auto sqe_ptr{ uring.GetSQE() };
+                if (sqe_ptr == nullptr) { break; }
 
-                if (entry_ptr->d_type == DT_DIR)
+                if (!statx_wait_list.empty())
                 {
-                    const auto dir_name_bytes{ std::strlen(entry_ptr->d_name) };
-                    entry_ptr->d_name[dir_name_bytes] = '/';
-                    search_dir_stack.push(std::move(std::string{ search_dir_name.data(), search_dir_name.size() }.append(entry_ptr->d_name, dir_name_bytes + 1)));
+                    const auto statx_op{ statx_wait_list.front().release() }; statx_wait_list.pop_front();
+                    ZXFS_STAT_INC(Stat);
+                    Plat::Uring::PrepStatx(sqe_ptr, statx_op->spDirOp->DirFD, statx_op->EntryName.c_str(), AT_SYMLINK_NOFOLLOW, STATX_TYPE, &statx_op->Statx, reinterpret_cast<std::uintptr_t>(statx_op) | 1);
                 }
                 else
                 {
-                    vcPaths.push_back(std::move(std::string{ file_path_ptr, file_path_prefix_bytes + search_dir_name.size() }.append(entry_ptr->d_name)));
+                    const auto dir_op{ new UringDirOp{ std::move(open_wait_list.back()) } }; open_wait_list.pop_back();
+                    dir_op->DirPath.assign(msBaseDir).append(dir_op->DirName);
+                    ZXFS_STAT_INC(OpenDir);
+                    Plat::Uring::PrepOpenAt(sqe_ptr, AT_FDCWD, dir_op->DirPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC, reinterpret_cast<std::uintptr_t>(dir_op));
                 }
-            } while ((entry_ptr = ::readdir(dir_ptr)) != nullptr);
 
-            const auto status{ ::closedir(dir_ptr) };
-            if (status == -1) { return false; }
+                inflight_count++;
+            }
 
-        } while (!search_dir_stack.empty());
+            if (inflight_count == 0) { break; }
+
+            if ((is_draining ? uring.Wait(1) : uring.Submit(1)) == false)
+            {
+                // the kernel may still write into the ops in flight, they are left allocated rather than freed under it
+                if (is_draining) { return false; }
+
+                // take back what the kernel never consumed, wait out the rest
+                is_failed = true;
+                is_draining = true;
+                std::uint64_t user_data;
+                while (uring.PopUnsubmitted(user_data))
+                {
+                    inflight_count--;
+                    if (user_data & 1) { delete reinterpret_cast<UringStatxOp*>(user_data & ~std::uint64_t{ 1 }); }
+                    else { delete reinterpret_cast<UringDirOp*>(user_data); }
+                }
+                continue;
+            }
+
+            std::uint64_t user_data;
+            std::int32_t result;
+            while (uring.PeekCQE(user_data, result))
+            {
+                inflight_count--;
+
+                if (user_data & 1)
+                {
+                    const std::unique_ptr<UringStatxOp> statx_op{ reinterpret_cast<UringStatxOp*>(user_data & ~std::uint64_t{ 1 }) };
+                    if (result != 0 || is_draining) { continue; }
+
+                    if (S_ISDIR(statx_op->Statx.stx_mode))
+                    {
+                        open_wait_list.emplace_back(std::string{ statx_op->spDirOp->DirName }.append(statx_op->EntryName).append(1, '/'));
+                    }
+                    else
+                    {
+                        emplace_file_path(statx_op->spDirOp->DirName, statx_op->EntryName);
+                    }
+                }
+                else
+                {
+                    std::unique_ptr<UringDirOp> dir_op{ reinterpret_cast<UringDirOp*>(user_data) };
+                    if ((result == -EINVAL) && dir_op->DirName.empty() && (inflight_count == 0)) // the op itself is refused (probe passed, e.g. a restricted ring), nothing else is in flight yet
+                    {
+                        return GetFilePathsRecursive<Policy>(vcPaths, msBaseDir, Searcher::MatchAll);
+                    }
+                    if (result < 0) { is_failed = true; continue; }
+                    dir_op->DirFD = result;
+                    if (is_draining) { continue; }
+
+                    std::shared_ptr<UringDirOp> dir_op_shared; // made on the first DT_UNKNOWN entry only
+                    const auto& dir_name{ dir_op->DirName };
+                    dir_reader.Attach(dir_op->DirFD);
+                    while (dir_reader.Next())
+                    {
+                        const auto entry_name{ dir_reader.GetName() };
+
+                        switch (dir_reader.GetType())
+                        {
+                        case DT_DIR: open_wait_list.emplace_back(std::string{ dir_name }.append(entry_name).append(1, '/')); break;
+                        case DT_UNKNOWN:
+                            if (dir_op_shared == nullptr) { dir_op_shared = std::move(dir_op); }
+                            statx_wait_list.emplace_back(new UringStatxOp{ dir_op_shared, std::string{ entry_name } });
+                            break;
+                        default: emplace_file_path(dir_name, entry_name);
+                        }
+                    }
+                    dir_reader.Detach();
+                }
+            }
+        }
+
+        return !is_failed;
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
+
+namespace ZQF::Zut::ZxFS
+{
+    struct SearchDirDeque
+    {
+        std::mutex Locker;
+        std::deque<std::string> DirNames;
+    };
+
+    static auto MergePaths(std::vector<std::string>& vcPaths, std::vector<std::vector<std::string>>& vcThreadPaths) -> void
+    {
+        std::size_t path_count{ vcPaths.size() };
+        for (const auto& paths : vcThreadPaths) { path_count += paths.size(); }
+        vcPaths.reserve(path_count);
+        for (auto& paths : vcThreadPaths) { std::ranges::move(paths, std::back_inserter(vcPaths)); }
+    }
+
+    static auto MergePaths(PathList& vcPaths, std::vector<PathList>& vcThreadPaths) -> void
+    {
+        std::size_t path_count{ vcPaths.size() };
+        std::size_t path_bytes{ vcPaths.bytes() };
+        for (const auto& paths : vcThreadPaths) { path_count += paths.size(); path_bytes += paths.bytes(); }
+        vcPaths.reserve(path_count, path_bytes);
+        for (const auto& paths : vcThreadPaths) { vcPaths.append(paths); }
+    }
+
+    template <typename Policy, typename PathContainer>
+    static auto GetFilePathsParallel(PathContainer& vcPaths, const std::string_view msBaseDir, const std::size_t nThreads, const Filter& rfFilter) -> bool
+    {
+        ZXFS_STAT_PHASE(Scan);
+        // every worker owns a deque of pending directory names (relative to msBaseDir),
+        // pops its own back (depth-first) and steals from the front of the others (oldest, usually biggest subtrees).
+        std::vector<SearchDirDeque> dir_deques(nThreads);
+        std::vector<PathContainer> thread_paths(nThreads);
+        std::atomic<std::size_t> pending_dirs{ 1 };
+        std::atomic<std::uint32_t> wake_epoch{}; // bumped on publish, last retire and failure, idle workers block on it instead of spinning
+        std::atomic<bool> is_failed{ false };
+        dir_deques[0].DirNames.emplace_back();
+
+        const auto wake_all = [&wake_epoch]
+        {
+            wake_epoch.fetch_add(1, std::memory_order_release);
+            wake_epoch.notify_all();
+        };
+
+        const auto worker = [&](const std::size_t nIndex)
+        {
+            auto& own_deque{ dir_deques[nIndex] };
+            auto& own_paths{ thread_paths[nIndex] };
+            Scratch::PathBuffer path_cache_lease;
+            auto& path_cache{ path_cache_lease.Get() };
+            std::vector<std::string> sub_dirs;
+
+            while (is_failed.load(std::memory_order_relaxed) == false)
+            {
+                const auto seen_epoch{ wake_epoch.load(std::memory_order_acquire) }; // read before looking, a publish after it wakes the wait below
+                std::optional<std::string> dir_name;
+
+                {
+                    std::scoped_lock lock{ own_deque.Locker };
+                    if (!own_deque.DirNames.empty()) { dir_name = std::move(own_deque.DirNames.back()); own_deque.DirNames.pop_back(); }
+                }
+
+                for (std::size_t offset{ 1 }; !dir_name.has_value() && offset < nThreads; offset++)
+                {
+                    auto& victim_deque{ dir_deques[(nIndex + offset) % nThreads] };
+                    std::scoped_lock lock{ victim_deque.Locker };
+                    if (!victim_deque.DirNames.empty()) { dir_name = std::move(victim_deque.DirNames.front()); victim_deque.DirNames.pop_front(); }
+                }
+
+                if (!dir_name.has_value())
+                {
+                    if (pending_dirs.load(std::memory_order_acquire) == 0) { break; }
+                    wake_epoch.wait(seen_epoch, std::memory_order_acquire);
+                    continue;
+                }
+
+                if (GetFilePathsOneDir<Policy>(own_paths, sub_dirs, path_cache, msBaseDir, *dir_name, rfFilter) == false)
+                {
+                    is_failed.store(true, std::memory_order_relaxed);
+                    wake_all();
+                    break;
+                }
+
+                // publish sub directories before retiring the current one, so pending_dirs never drops to zero early.
+                if (!sub_dirs.empty())
+                {
+                    pending_dirs.fetch_add(sub_dirs.size(), std::memory_order_relaxed);
+                    {
+                        std::scoped_lock lock{ own_deque.Locker };
+                        std::ranges::move(sub_dirs, std::back_inserter(own_deque.DirNames));
+                    }
+                    sub_dirs.clear();
+                    wake_all();
+                }
+
+                if (pending_dirs.fetch_sub(1, std::memory_order_acq_rel) == 1) { wake_all(); }
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(nThreads - 1);
+            for (std::size_t index{ 1 }; index < nThreads; index++) { threads.emplace_back(worker, index); }
+            worker(0);
+        }
+
+        if (is_failed.load()) { return false; }
+
+        MergePaths(vcPaths, thread_paths);
 
         return true;
     }
 
+    template <typename Policy, typename PathContainer>
+    static auto SearchImp(PathContainer& vcPaths, const std::string_view msSearchDir, const Filter& rfFilter) -> bool
+    {
+        if (!msSearchDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxPath::Walk::GetFilePaths(): dir format error! -> " }.append(msSearchDir)); }
+
+        ZXFS_STAT_PHASE(Scan);
+        if constexpr (Policy::IsRecursive) { return GetFilePathsRecursive<Policy>(vcPaths, msSearchDir, rfFilter); }
+        else { return GetFilePathsCurDir<Policy>(vcPaths, msSearchDir, rfFilter); }
+    }
+
+    // the runtime flags only pick an instantiation, the current directory reports regular files, the recursive scan everything but directories
+    template <bool IS_FILTERED, typename PathContainer>
+    static auto GetFilePathsImp(PathContainer& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const Filter& rfFilter) -> bool
+    {
+        if (isRecursive)
+        {
+            return isWithDir
+                ? SearchImp<SearchPolicy<true, true, SearchType::NonDir, IS_FILTERED>>(vcPaths, msSearchDir, rfFilter)
+                : SearchImp<SearchPolicy<true, false, SearchType::NonDir, IS_FILTERED>>(vcPaths, msSearchDir, rfFilter);
+        }
+
+        return isWithDir
+            ? SearchImp<SearchPolicy<false, true, SearchType::File, IS_FILTERED>>(vcPaths, msSearchDir, rfFilter)
+            : SearchImp<SearchPolicy<false, false, SearchType::File, IS_FILTERED>>(vcPaths, msSearchDir, rfFilter);
+    }
+
+    template <bool IS_FILTERED, typename PathContainer>
+    static auto GetFilePathsImp(PathContainer& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads, const Filter& rfFilter) -> bool
+    {
+        if (!msSearchDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxPath::Walk::GetFilePaths(): dir format error! -> " }.append(msSearchDir)); }
+
+        const auto thread_count{ Pool::ThreadCount(nThreads) };
+        if (!isRecursive || thread_count == 1) { return GetFilePathsImp<IS_FILTERED>(vcPaths, msSearchDir, isWithDir, isRecursive, rfFilter); }
+
+        return isWithDir
+            ? GetFilePathsParallel<SearchPolicy<true, true, SearchType::NonDir, IS_FILTERED>>(vcPaths, msSearchDir, thread_count, rfFilter)
+            : GetFilePathsParallel<SearchPolicy<true, false, SearchType::NonDir, IS_FILTERED>>(vcPaths, msSearchDir, thread_count, rfFilter);
+    }
+
+    template <typename PathContainer>
+    static auto GetFilePathsAsyncImp(PathContainer& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const std::size_t nQueueDepth) -> bool
+    {
+        if (!msSearchDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxPath::Walk::GetFilePathsAsync(): dir format error! -> " }.append(msSearchDir)); }
+        return isWithDir
+            ? GetFilePathsQueued<SearchPolicy<true, true, SearchType::NonDir>>(vcPaths, msSearchDir, nQueueDepth)
+            : GetFilePathsQueued<SearchPolicy<true, false, SearchType::NonDir>>(vcPaths, msSearchDir, nQueueDepth);
+    }
+
+    template <typename Policy>
+    auto Searcher::Search(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const Filter& rfFilter) -> bool
+    {
+        return SearchImp<Policy>(vcPaths, msSearchDir, rfFilter);
+    }
+
+    template <typename Policy>
+    auto Searcher::Search(PathList& vcPaths, const std::string_view msSearchDir, const Filter& rfFilter) -> bool
+    {
+        return SearchImp<Policy>(vcPaths, msSearchDir, rfFilter);
+    }
+
+    template <typename Policy>
+    auto Searcher::Visit(const std::string_view msSearchDir, const std::function<bool(std::string_view)>& fnVisitor, const Filter& rfFilter) -> bool
+    {
+        SearchVisitor visitor{ fnVisitor };
+        return SearchImp<Policy>(visitor, msSearchDir, rfFilter);
+    }
+
+#define ZXFS_SEARCHER_INSTANTIATE(IS_RECURSIVE, IS_WITH_DIR, ACCEPT_TYPES, IS_FILTERED) \
+    template auto Searcher::Search<SearchPolicy<IS_RECURSIVE, IS_WITH_DIR, ACCEPT_TYPES, IS_FILTERED>>(std::vector<std::string>&, const std::string_view, const Filter&) -> bool; \
+    template auto Searcher::Search<SearchPolicy<IS_RECURSIVE, IS_WITH_DIR, ACCEPT_TYPES, IS_FILTERED>>(PathList&, const std::string_view, const Filter&) -> bool; \
+    template auto Searcher::Visit<SearchPolicy<IS_RECURSIVE, IS_WITH_DIR, ACCEPT_TYPES, IS_FILTERED>>(const std::string_view, const std::function<bool(std::string_view)>&, const Filter&) -> bool;
+
+#define ZXFS_SEARCHER_INSTANTIATE_TYPES(IS_RECURSIVE, IS_WITH_DIR, IS_FILTERED) \
+    ZXFS_SEARCHER_INSTANTIATE(IS_RECURSIVE, IS_WITH_DIR, SearchType::File, IS_FILTERED) \
+    ZXFS_SEARCHER_INSTANTIATE(IS_RECURSIVE, IS_WITH_DIR, SearchType::Dir, IS_FILTERED) \
+    ZXFS_SEARCHER_INSTANTIATE(IS_RECURSIVE, IS_WITH_DIR, SearchType::NonDir, IS_FILTERED) \
+    ZXFS_SEARCHER_INSTANTIATE(IS_RECURSIVE, IS_WITH_DIR, SearchType::All, IS_FILTERED)
+
+    ZXFS_SEARCHER_INSTANTIATE_TYPES(false, false, false)
+    ZXFS_SEARCHER_INSTANTIATE_TYPES(false, false, true)
+    ZXFS_SEARCHER_INSTANTIATE_TYPES(false, true, false)
+    ZXFS_SEARCHER_INSTANTIATE_TYPES(false, true, true)
+    ZXFS_SEARCHER_INSTANTIATE_TYPES(true, false, false)
+    ZXFS_SEARCHER_INSTANTIATE_TYPES(true, false, true)
+    ZXFS_SEARCHER_INSTANTIATE_TYPES(true, true, false)
+    ZXFS_SEARCHER_INSTANTIATE_TYPES(true, true, true)
+
+#undef ZXFS_SEARCHER_INSTANTIATE_TYPES
+#undef ZXFS_SEARCHER_INSTANTIATE
+
     auto Searcher::GetFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive) -> std::vector<std::string>
     {
         std::vector<std::string> file_path_list;
@@ -235,8 +860,85 @@ namespace ZQF::Zut::ZxFS
 
     auto Searcher::GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive) -> bool
     {
-        if (!msSearchDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxPath::Walk::GetFilePaths(): dir format error! -> " }.append(msSearchDir)); }
-        return isRecursive ? GetFilePathsRecursive(vcPaths, msSearchDir, isWithDir) : GetFilePathsCurDir(vcPaths, msSearchDir, isWithDir);
+        return GetFilePathsImp<false>(vcPaths, msSearchDir, isWithDir, isRecursive, Searcher::MatchAll);
+    }
+
+    auto Searcher::GetFilePaths(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive) -> bool
+    {
+        return GetFilePathsImp<false>(vcPaths, msSearchDir, isWithDir, isRecursive, Searcher::MatchAll);
+    }
+
+    auto Searcher::GetFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads) -> std::vector<std::string>
+    {
+        std::vector<std::string> file_path_list;
+        const auto status = Searcher::GetFilePaths(file_path_list, msSearchDir, isWithDir, isRecursive, nThreads);
+        if (status == false) { throw std::runtime_error(std::string{ "ZxPath::Walk::GetFilePaths(): dir open error! -> " }.append(msSearchDir)); }
+        return file_path_list;
+    }
+
+    auto Searcher::GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads) -> bool
+    {
+        return GetFilePathsImp<false>(vcPaths, msSearchDir, isWithDir, isRecursive, nThreads, Searcher::MatchAll);
+    }
+
+    auto Searcher::GetFilePaths(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads) -> bool
+    {
+        return GetFilePathsImp<false>(vcPaths, msSearchDir, isWithDir, isRecursive, nThreads, Searcher::MatchAll);
+    }
+
+    auto Searcher::VisitFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::function<bool(std::string_view)>& fnVisitor) -> bool
+    {
+        SearchVisitor visitor{ fnVisitor };
+        return GetFilePathsImp<false>(visitor, msSearchDir, isWithDir, isRecursive, Searcher::MatchAll);
+    }
+
+    auto Searcher::VisitEntries(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::uint32_t nStatFields, const std::function<bool(std::string_view, Entry&)>& fnVisitor) -> bool
+    {
+        SearchEntryVisitor visitor{ fnVisitor, nStatFields };
+        return GetFilePathsImp<false>(visitor, msSearchDir, isWithDir, isRecursive, Searcher::MatchAll);
+    }
+
+    auto Searcher::GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const Filter& rfFilter) -> bool
+    {
+        return GetFilePathsImp<true>(vcPaths, msSearchDir, isWithDir, isRecursive, rfFilter);
+    }
+
+    auto Searcher::GetFilePaths(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const Filter& rfFilter) -> bool
+    {
+        return GetFilePathsImp<true>(vcPaths, msSearchDir, isWithDir, isRecursive, rfFilter);
+    }
+
+    auto Searcher::GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads, const Filter& rfFilter) -> bool
+    {
+        return GetFilePathsImp<true>(vcPaths, msSearchDir, isWithDir, isRecursive, nThreads, rfFilter);
+    }
+
+    auto Searcher::GetFilePaths(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads, const Filter& rfFilter) -> bool
+    {
+        return GetFilePathsImp<true>(vcPaths, msSearchDir, isWithDir, isRecursive, nThreads, rfFilter);
+    }
+
+    auto Searcher::VisitFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const Filter& rfFilter, const std::function<bool(std::string_view)>& fnVisitor) -> bool
+    {
+        SearchVisitor visitor{ fnVisitor };
+        return GetFilePathsImp<true>(visitor, msSearchDir, isWithDir, isRecursive, rfFilter);
+    }
+
+    auto Searcher::GetFilePathsAsync(const std::string_view msSearchDir, const bool isWithDir, const std::size_t nQueueDepth) -> std::vector<std::string>
+    {
+        std::vector<std::string> file_path_list;
+        const auto status = Searcher::GetFilePathsAsync(file_path_list, msSearchDir, isWithDir, nQueueDepth);
+        if (status == false) { throw std::runtime_error(std::string{ "ZxPath::Walk::GetFilePathsAsync(): dir open error! -> " }.append(msSearchDir)); }
+        return file_path_list;
+    }
+
+    auto Searcher::GetFilePathsAsync(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const std::size_t nQueueDepth) -> bool
+    {
+        return GetFilePathsAsyncImp(vcPaths, msSearchDir, isWithDir, nQueueDepth);
+    }
+
+    auto Searcher::GetFilePathsAsync(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const std::size_t nQueueDepth) -> bool
+    {
+        return GetFilePathsAsyncImp(vcPaths, msSearchDir, isWithDir, nQueueDepth);
     }
 } // namespace ZQF::Zut::ZxFS
-#endif
@@ -1,16 +1,79 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <functional>
+#include <cstdint>
 #include <string_view>
+#include <Zut/ZxFS/Entry.h>
+#include <Zut/ZxFS/Filter.h>
+#include <Zut/ZxFS/PathList.h>
 
 
 namespace ZQF::Zut::ZxFS
 {
+    // entry types a search reports, directories are reported with a trailing '/'
+    struct SearchType
+    {
+        static constexpr std::uint32_t File{ 0x1 };
+        static constexpr std::uint32_t Dir{ 0x2 };
+        static constexpr std::uint32_t Other{ 0x4 }; // symlinks, fifos, sockets, devices (never reported on windows)
+        static constexpr std::uint32_t NonDir{ File | Other };
+        static constexpr std::uint32_t All{ File | Dir | Other };
+    };
+
+    // compile-time search configuration, every combination is its own scan loop without per-entry checks of disabled options.
+    // IS_FILTERED == false skips the Filter entirely, the Filter argument is ignored then.
+    template <bool IS_RECURSIVE, bool IS_WITH_DIR, std::uint32_t ACCEPT_TYPES = SearchType::File, bool IS_FILTERED = false>
+    struct SearchPolicy
+    {
+        static_assert(ACCEPT_TYPES == SearchType::File || ACCEPT_TYPES == SearchType::Dir || ACCEPT_TYPES == SearchType::NonDir || ACCEPT_TYPES == SearchType::All, "SearchPolicy: only File, Dir, NonDir and All are instantiated");
+
+        static constexpr bool IsRecursive{ IS_RECURSIVE };
+        static constexpr bool IsWithDir{ IS_WITH_DIR };
+        static constexpr std::uint32_t AcceptTypes{ ACCEPT_TYPES };
+        static constexpr bool IsFiltered{ IS_FILTERED };
+    };
+
     class Searcher
     {
     public:
+        static inline const Filter MatchAll{};
+
+    public:
+        // Policy is a SearchPolicy, the output sink is picked by overload. instantiated for every valid SearchPolicy.
+        template <typename Policy> static auto Search(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const Filter& rfFilter = Searcher::MatchAll) -> bool;
+        template <typename Policy> static auto Search(PathList& vcPaths, const std::string_view msSearchDir, const Filter& rfFilter = Searcher::MatchAll) -> bool;
+        template <typename Policy> static auto Visit(const std::string_view msSearchDir, const std::function<bool(std::string_view)>& fnVisitor, const Filter& rfFilter = Searcher::MatchAll) -> bool;
+
+    public:
+        // the bool overloads pick a SearchPolicy at runtime: regular files of the directory itself, or everything but directories when recursive
         static auto GetFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive) -> std::vector<std::string>;
         static auto GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive) -> bool;
+        static auto GetFilePaths(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive) -> bool;
+
+        // streams every path to fnVisitor as soon as it is read, the view is null-terminated and borrowed from the
+        // internal path buffer (valid only during the call). return false from fnVisitor to stop the search early.
+        static auto VisitFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::function<bool(std::string_view)>& fnVisitor) -> bool;
+        // same as VisitFilePaths, plus the file's typed entry. nStatFields (EntryField) is what the entry's first lazy statx
+        // fetches, relative to the open directory fd, so no path-based stat pass is needed afterwards.
+        static auto VisitEntries(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::uint32_t nStatFields, const std::function<bool(std::string_view, Entry&)>& fnVisitor) -> bool;
+
+        // nThreads == 0 -> std::thread::hardware_concurrency()
+        static auto GetFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads) -> std::vector<std::string>;
+        static auto GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads) -> bool;
+        static auto GetFilePaths(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads) -> bool;
+
+        // recursive, keeps up to nQueueDepth directory opens / statx in flight (io_uring), falls back to the serial scan when io_uring or its openat/statx ops are unavailable
+        static auto GetFilePathsAsync(const std::string_view msSearchDir, const bool isWithDir, const std::size_t nQueueDepth) -> std::vector<std::string>;
+        static auto GetFilePathsAsync(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const std::size_t nQueueDepth) -> bool;
+        static auto GetFilePathsAsync(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const std::size_t nQueueDepth) -> bool;
+
+        // rfFilter is checked against the bare entry name inside the scan loop, rejected files never build a path string
+        static auto GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const Filter& rfFilter) -> bool;
+        static auto GetFilePaths(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const Filter& rfFilter) -> bool;
+        static auto GetFilePaths(std::vector<std::string>& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads, const Filter& rfFilter) -> bool;
+        static auto GetFilePaths(PathList& vcPaths, const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const std::size_t nThreads, const Filter& rfFilter) -> bool;
+        static auto VisitFilePaths(const std::string_view msSearchDir, const bool isWithDir, const bool isRecursive, const Filter& rfFilter, const std::function<bool(std::string_view)>& fnVisitor) -> bool;
 
     };
 } // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+
+
+// little helpers of the on-disk formats (ScanIndex, ScanCursor), native endian, every string is a u64 byte count followed by its bytes
+namespace ZQF::Zut::ZxFS
+{
+    inline auto WriteU64(std::ofstream& rfStream, const std::uint64_t nValue) -> void
+    {
+        rfStream.write(reinterpret_cast<const char*>(&nValue), sizeof(nValue));
+    }
+
+    inline auto WriteStr(std::ofstream& rfStream, const std::string_view msStr) -> void
+    {
+        ZxFS::WriteU64(rfStream, msStr.size());
+        rfStream.write(msStr.data(), static_cast<std::streamsize>(msStr.size()));
+    }
+
+    inline auto ReadU64(std::ifstream& rfStream) -> std::uint64_t
+    {
+        std::uint64_t value{};
+        rfStream.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+
+    inline auto ReadStr(std::ifstream& rfStream, std::string& msStr) -> bool
+    {
+        const auto bytes{ ZxFS::ReadU64(rfStream) };
+        if (!rfStream || bytes > 0x10000) { return false; } // far beyond any path, the file is corrupt
+        msStr.resize(static_cast<std::size_t>(bytes));
+        rfStream.read(msStr.data(), static_cast<std::streamsize>(bytes));
+        return static_cast<bool>(rfStream);
+    }
+
+    inline auto ReadStrList(std::ifstream& rfStream, std::vector<std::string>& vcStrs) -> bool
+    {
+        const auto count{ ZxFS::ReadU64(rfStream) };
+        if (!rfStream) { return false; }
+        vcStrs.clear();
+        for (std::uint64_t index{}; index < count; index++)
+        {
+            if (ZxFS::ReadStr(rfStream, vcStrs.emplace_back()) == false) { return false; }
+        }
+        return true;
+    }
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,97 @@
+#include "Stats.h"
+#include "Probe.h"
+
+
+#ifdef ZXFS_STATS
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+
+namespace ZQF::Zut::ZxFS::Probe
+{
+    // live blocks plus the totals of threads that already exited
+    struct Registry
+    {
+        std::mutex Locker;
+        std::vector<ThreadBlock*> Blocks;
+        StatSnapshot Retired;
+    };
+
+    static auto GetRegistry() -> Registry&
+    {
+        static Registry registry; // outlives every thread_local block that registers after it
+        return registry;
+    }
+
+    ThreadBlock::ThreadBlock()
+    {
+        auto& registry{ GetRegistry() };
+        std::scoped_lock lock{ registry.Locker };
+        registry.Blocks.push_back(this);
+    }
+
+    ThreadBlock::~ThreadBlock()
+    {
+        auto& registry{ GetRegistry() };
+        std::scoped_lock lock{ registry.Locker };
+        for (std::size_t index{}; index < StatCounter::Count; index++) { registry.Retired.Counters[index] += Counters[index].load(std::memory_order_relaxed); }
+        for (std::size_t index{}; index < StatCounter::Count; index++) { registry.Retired.CallNS[index] += CallNS[index].load(std::memory_order_relaxed); }
+        for (std::size_t index{}; index < StatPhase::Count; index++) { registry.Retired.PhaseNS[index] += PhaseNS[index].load(std::memory_order_relaxed); }
+        std::erase(registry.Blocks, this);
+    }
+
+    auto Local() -> ThreadBlock&
+    {
+        thread_local ThreadBlock block;
+        return block;
+    }
+} // namespace ZQF::Zut::ZxFS::Probe
+
+
+namespace ZQF::Zut::ZxFS
+{
+    auto Stats::Snapshot() -> StatSnapshot
+    {
+        auto& registry{ Probe::GetRegistry() };
+        std::scoped_lock lock{ registry.Locker };
+
+        auto snapshot{ registry.Retired };
+        for (const auto block_ptr : registry.Blocks)
+        {
+            for (std::size_t index{}; index < StatCounter::Count; index++) { snapshot.Counters[index] += block_ptr->Counters[index].load(std::memory_order_relaxed); }
+            for (std::size_t index{}; index < StatCounter::Count; index++) { snapshot.CallNS[index] += block_ptr->CallNS[index].load(std::memory_order_relaxed); }
+            for (std::size_t index{}; index < StatPhase::Count; index++) { snapshot.PhaseNS[index] += block_ptr->PhaseNS[index].load(std::memory_order_relaxed); }
+        }
+
+        return snapshot;
+    }
+
+    auto Stats::Reset() -> void
+    {
+        auto& registry{ Probe::GetRegistry() };
+        std::scoped_lock lock{ registry.Locker };
+
+        registry.Retired = {};
+        for (const auto block_ptr : registry.Blocks)
+        {
+            for (auto& counter : block_ptr->Counters) { counter.store(0, std::memory_order_relaxed); }
+            for (auto& call_ns : block_ptr->CallNS) { call_ns.store(0, std::memory_order_relaxed); }
+            for (auto& phase_ns : block_ptr->PhaseNS) { phase_ns.store(0, std::memory_order_relaxed); }
+        }
+    }
+} // namespace ZQF::Zut::ZxFS
+#else
+namespace ZQF::Zut::ZxFS
+{
+    auto Stats::Snapshot() -> StatSnapshot
+    {
+        return {};
+    }
+
+    auto Stats::Reset() -> void
+    {
+
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
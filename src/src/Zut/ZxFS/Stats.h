@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // what the library counts, syscalls first (io_uring ops count under their syscall)
+    struct StatCounter
+    {
+        static constexpr std::size_t OpenDir{ 0 };      // open / openat of a directory, FindFirstFileEx
+        static constexpr std::size_t ReadDir{ 1 };      // getdents64
+        static constexpr std::size_t Stat{ 2 };         // stat / fstat / fstatat / statx
+        static constexpr std::size_t OpenFile{ 3 };
+        static constexpr std::size_t Unlink{ 4 };       // unlink / unlinkat / rmdir / remove
+        static constexpr std::size_t Rename{ 5 };
+        static constexpr std::size_t MakeDir{ 6 };
+        static constexpr std::size_t CopyCall{ 7 };     // copy_file_range / sendfile / pread + pwrite / FICLONE / CopyFile
+        static constexpr std::size_t UringEnter{ 8 };
+        static constexpr std::size_t DirVisited{ 9 };
+        static constexpr std::size_t EntrySeen{ 10 };
+        static constexpr std::size_t EntrySkipped{ 11 }; // read but not reported (wrong type, rejected by a filter)
+        static constexpr std::size_t BytesCopied{ 12 };
+        static constexpr std::size_t Count{ 13 };
+
+        static constexpr std::array<std::string_view, Count> Names{ "open_dir", "read_dir", "stat", "open_file", "unlink", "rename", "make_dir", "copy_call", "uring_enter", "dir_visited", "entry_seen", "entry_skipped", "bytes_copied" };
+    };
+
+    // wall time of the top-level operations, per thread that ran them (so parallel phases sum up across workers).
+    // StatSnapshot::CallNS splits it further into the syscalls underneath.
+    struct StatPhase
+    {
+        static constexpr std::size_t Scan{ 0 };   // Searcher
+        static constexpr std::size_t Size{ 1 };   // FileSize / Exist batches, DirSize
+        static constexpr std::size_t Copy{ 2 };   // FileCopy
+        static constexpr std::size_t Delete{ 3 }; // FileDelete batches, DirContentDelete / DirDeleteRecursive
+        static constexpr std::size_t Make{ 4 };   // DirMakeRecursive
+        static constexpr std::size_t Move{ 5 };   // FileMove batches
+        static constexpr std::size_t Count{ 6 };
+
+        static constexpr std::array<std::string_view, Count> Names{ "scan", "size", "copy", "delete", "make", "move" };
+    };
+
+    struct StatSnapshot
+    {
+        std::array<std::uint64_t, StatCounter::Count> Counters{};
+        std::array<std::uint64_t, StatCounter::Count> CallNS{}; // time spent inside the counted calls: open_dir, read_dir, stat, unlink (sync calls only, io_uring waits land in no slot)
+        std::array<std::uint64_t, StatPhase::Count> PhaseNS{};
+    };
+
+    // every thread counts into its own block, Snapshot sums the live blocks and those of exited threads.
+    // only collected when the library is built with ZXFS_STATS (cmake -DZXFS_STATS=ON), all zero otherwise.
+    class Stats
+    {
+    public:
+#ifdef ZXFS_STATS
+        static constexpr bool IsEnabled{ true };
+#else
+        static constexpr bool IsEnabled{ false };
+#endif
+
+    public:
+        static auto Snapshot() -> StatSnapshot;
+        static auto Reset() -> void; // only exact while no ZxFS call is running
+    };
+} // namespace ZQF::Zut::ZxFS
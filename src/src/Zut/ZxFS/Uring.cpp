@@ -0,0 +1,209 @@
+#include "Uring.h"
+#include "Probe.h"
+
+
+#ifdef __linux__
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+
+
+namespace ZQF::Zut::ZxFS::Plat
+{
+    Uring::~Uring()
+    {
+        if (m_pSQEs != nullptr) { ::munmap(m_pSQEs, m_nSQEsBytes); }
+        if (m_pCQRing != nullptr && m_pCQRing != m_pSQRing) { ::munmap(m_pCQRing, m_nCQRingBytes); }
+        if (m_pSQRing != nullptr) { ::munmap(m_pSQRing, m_nSQRingBytes); }
+        if (m_nFD != -1) { ::close(m_nFD); }
+    }
+
+    auto Uring::Init(const unsigned nEntries) -> bool
+    {
+        io_uring_params params{};
+        const auto ring_fd{ static_cast<int>(::syscall(__NR_io_uring_setup, nEntries, &params)) };
+        if (ring_fd == -1) { return false; }
+        m_nFD = ring_fd;
+        m_nEntries = params.sq_entries;
+
+        m_nSQRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_nCQRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const auto is_single_mmap{ (params.features & IORING_FEAT_SINGLE_MMAP) != 0 };
+        if (is_single_mmap) { m_nSQRingBytes = m_nCQRingBytes = std::max(m_nSQRingBytes, m_nCQRingBytes); }
+
+        const auto sq_ring_ptr{ ::mmap(nullptr, m_nSQRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_nFD, IORING_OFF_SQ_RING) };
+        if (sq_ring_ptr == MAP_FAILED) { return false; }
+        m_pSQRing = sq_ring_ptr;
+
+        if (is_single_mmap)
+        {
+            m_pCQRing = m_pSQRing;
+        }
+        else
+        {
+            const auto cq_ring_ptr{ ::mmap(nullptr, m_nCQRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_nFD, IORING_OFF_CQ_RING) };
+            if (cq_ring_ptr == MAP_FAILED) { return false; }
+            m_pCQRing = cq_ring_ptr;
+        }
+
+        m_nSQEsBytes = params.sq_entries * sizeof(io_uring_sqe);
+        const auto sqes_ptr{ ::mmap(nullptr, m_nSQEsBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_nFD, IORING_OFF_SQES) };
+        if (sqes_ptr == MAP_FAILED) { return false; }
+        m_pSQEs = static_cast<io_uring_sqe*>(sqes_ptr);
+
+        const auto sq_ring_bytes_ptr{ static_cast<std::uint8_t*>(m_pSQRing) };
+        m_pSQHead = reinterpret_cast<unsigned*>(sq_ring_bytes_ptr + params.sq_off.head);
+        m_pSQTail = reinterpret_cast<unsigned*>(sq_ring_bytes_ptr + params.sq_off.tail);
+        m_pSQMask = reinterpret_cast<unsigned*>(sq_ring_bytes_ptr + params.sq_off.ring_mask);
+        m_pSQArray = reinterpret_cast<unsigned*>(sq_ring_bytes_ptr + params.sq_off.array);
+
+        const auto cq_ring_bytes_ptr{ static_cast<std::uint8_t*>(m_pCQRing) };
+        m_pCQHead = reinterpret_cast<unsigned*>(cq_ring_bytes_ptr + params.cq_off.head);
+        m_pCQTail = reinterpret_cast<unsigned*>(cq_ring_bytes_ptr + params.cq_off.tail);
+        m_pCQMask = reinterpret_cast<unsigned*>(cq_ring_bytes_ptr + params.cq_off.ring_mask);
+        m_pCQEs = reinterpret_cast<io_uring_cqe*>(cq_ring_bytes_ptr + params.cq_off.cqes);
+
+        m_nSQTail = *m_pSQTail;
+        m_nSQSubmitted = m_nSQTail;
+
+        // a kernel without the probe also predates openat/statx, leaving every op unsupported is right for it
+        const auto probe_bytes{ sizeof(io_uring_probe) + m_bsSupportedOps.size() * sizeof(io_uring_probe_op) };
+        const auto probe_buffer{ std::make_unique<std::uint64_t[]>((probe_bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)) };
+        const auto probe_ptr{ reinterpret_cast<io_uring_probe*>(probe_buffer.get()) };
+        if (::syscall(__NR_io_uring_register, m_nFD, IORING_REGISTER_PROBE, probe_ptr, static_cast<unsigned>(m_bsSupportedOps.size())) != -1)
+        {
+            for (std::size_t index{}; index < probe_ptr->ops_len; index++)
+            {
+                if (probe_ptr->ops[index].flags & IO_URING_OP_SUPPORTED) { m_bsSupportedOps.set(probe_ptr->ops[index].op); }
+            }
+        }
+
+        return true;
+    }
+
+    auto Uring::GetEntries() const -> unsigned
+    {
+        return m_nEntries;
+    }
+
+    auto Uring::IsOpSupported(const std::uint8_t nOp) const -> bool
+    {
+        return m_bsSupportedOps.test(nOp);
+    }
+
+    auto Uring::GetSQE() -> io_uring_sqe*
+    {
+        const auto sq_head{ std::atomic_ref<unsigned>{ *m_pSQHead }.load(std::memory_order_acquire) };
+        if ((m_nSQTail - sq_head) >= m_nEntries) { return nullptr; }
+
+        const auto index{ m_nSQTail & *m_pSQMask };
+        m_pSQArray[index] = index;
+        m_nSQTail++;
+
+        const auto sqe_ptr{ m_pSQEs + index };
+        std::memset(sqe_ptr, 0, sizeof(io_uring_sqe));
+        return sqe_ptr;
+    }
+
+    auto Uring::Submit(const unsigned nWaitCompletions) -> bool
+    {
+        std::atomic_ref<unsigned>{ *m_pSQTail }.store(m_nSQTail, std::memory_order_release);
+
+        const auto to_submit{ m_nSQTail - m_nSQSubmitted };
+        const auto flags{ nWaitCompletions != 0 ? IORING_ENTER_GETEVENTS : 0u };
+
+        while (true)
+        {
+            ZXFS_STAT_INC(UringEnter);
+            const auto submitted{ ::syscall(__NR_io_uring_enter, m_nFD, to_submit, nWaitCompletions, flags, nullptr, 0) };
+            if (submitted == -1 && errno == EINTR) { continue; }
+            if (submitted == -1) { return false; }
+            m_nSQSubmitted += static_cast<unsigned>(submitted);
+            return true;
+        }
+    }
+
+    auto Uring::Wait(const unsigned nWaitCompletions) -> bool
+    {
+        while (true)
+        {
+            ZXFS_STAT_INC(UringEnter);
+            const auto status{ ::syscall(__NR_io_uring_enter, m_nFD, 0, nWaitCompletions, IORING_ENTER_GETEVENTS, nullptr, 0) };
+            if (status == -1 && errno == EINTR) { continue; }
+            return status != -1;
+        }
+    }
+
+    auto Uring::PeekCQE(std::uint64_t& nUserData, std::int32_t& nResult) -> bool
+    {
+        const auto cq_head{ *m_pCQHead };
+        const auto cq_tail{ std::atomic_ref<unsigned>{ *m_pCQTail }.load(std::memory_order_acquire) };
+        if (cq_head == cq_tail) { return false; }
+
+        const auto& cqe{ m_pCQEs[cq_head & *m_pCQMask] };
+        nUserData = cqe.user_data;
+        nResult = cqe.res;
+
+        std::atomic_ref<unsigned>{ *m_pCQHead }.store(cq_head + 1, std::memory_order_release);
+        return true;
+    }
+
+    auto Uring::PopUnsubmitted(std::uint64_t& nUserData) -> bool
+    {
+        // without SQPOLL the kernel only consumes SQEs inside io_uring_enter, so everything past m_nSQSubmitted is still ours
+        if (m_nSQTail == m_nSQSubmitted) { return false; }
+
+        m_nSQTail--;
+        nUserData = m_pSQEs[m_nSQTail & *m_pSQMask].user_data;
+        std::atomic_ref<unsigned>{ *m_pSQTail }.store(m_nSQTail, std::memory_order_release);
+        return true;
+    }
+
+    auto Uring::PrepOpenAt(io_uring_sqe* pSQE, const int nDirFD, const char* cpPath, const int nFlags, const std::uint64_t nUserData) -> void
+    {
+        pSQE->opcode = IORING_OP_OPENAT;
+        pSQE->fd = nDirFD;
+        pSQE->addr = reinterpret_cast<std::uint64_t>(cpPath);
+        pSQE->open_flags = static_cast<std::uint32_t>(nFlags);
+        pSQE->user_data = nUserData;
+    }
+
+    auto Uring::PrepStatx(io_uring_sqe* pSQE, const int nDirFD, const char* cpPath, const int nFlags, const unsigned nMask, struct statx* pStatx, const std::uint64_t nUserData) -> void
+    {
+        pSQE->opcode = IORING_OP_STATX;
+        pSQE->fd = nDirFD;
+        pSQE->addr = reinterpret_cast<std::uint64_t>(cpPath);
+        pSQE->len = nMask;
+        pSQE->off = reinterpret_cast<std::uint64_t>(pStatx);
+        pSQE->statx_flags = static_cast<std::uint32_t>(nFlags);
+        pSQE->user_data = nUserData;
+    }
+
+    auto Uring::PrepUnlinkAt(io_uring_sqe* pSQE, const int nDirFD, const char* cpPath, const int nFlags, const std::uint64_t nUserData) -> void
+    {
+        pSQE->opcode = IORING_OP_UNLINKAT;
+        pSQE->fd = nDirFD;
+        pSQE->addr = reinterpret_cast<std::uint64_t>(cpPath);
+        pSQE->unlink_flags = static_cast<std::uint32_t>(nFlags);
+        pSQE->user_data = nUserData;
+    }
+
+    auto Uring::PrepRenameAt(io_uring_sqe* pSQE, const int nOldDirFD, const char* cpOldPath, const int nNewDirFD, const char* cpNewPath, const unsigned nFlags, const std::uint64_t nUserData) -> void
+    {
+        pSQE->opcode = IORING_OP_RENAMEAT;
+        pSQE->fd = nOldDirFD;
+        pSQE->addr = reinterpret_cast<std::uint64_t>(cpOldPath);
+        pSQE->len = static_cast<std::uint32_t>(nNewDirFD);
+        pSQE->addr2 = reinterpret_cast<std::uint64_t>(cpNewPath);
+        pSQE->rename_flags = nFlags;
+        pSQE->user_data = nUserData;
+    }
+} // namespace ZQF::Zut::ZxFS::Plat
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+#include <cstddef>
+
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+
+
+struct statx;
+
+namespace ZQF::Zut::ZxFS::Plat
+{
+    // minimal raw io_uring wrapper (no liburing dependency), single-threaded use only.
+    class Uring
+    {
+    private:
+        int m_nFD{ -1 };
+        unsigned m_nEntries{};
+        unsigned m_nSQTail{};
+        unsigned m_nSQSubmitted{};
+
+        void* m_pSQRing{};
+        void* m_pCQRing{};
+        std::size_t m_nSQRingBytes{};
+        std::size_t m_nCQRingBytes{};
+        io_uring_sqe* m_pSQEs{};
+        std::size_t m_nSQEsBytes{};
+
+        unsigned* m_pSQHead{};
+        unsigned* m_pSQTail{};
+        unsigned* m_pSQMask{};
+        unsigned* m_pSQArray{};
+        unsigned* m_pCQHead{};
+        unsigned* m_pCQTail{};
+        unsigned* m_pCQMask{};
+        io_uring_cqe* m_pCQEs{};
+
+        std::bitset<256> m_bsSupportedOps;
+
+    public:
+        Uring() = default;
+        Uring(const Uring&) = delete;
+        auto operator=(const Uring&) -> Uring& = delete;
+        ~Uring();
+
+    public:
+        auto Init(const unsigned nEntries) -> bool;
+        auto GetEntries() const -> unsigned;
+        auto IsOpSupported(const std::uint8_t nOp) const -> bool; // IORING_REGISTER_PROBE, false for every op on kernels without it (< 5.6)
+
+    public:
+        auto GetSQE() -> io_uring_sqe*; // nullptr when the submission queue is full
+        auto Submit(const unsigned nWaitCompletions) -> bool;
+        auto Wait(const unsigned nWaitCompletions) -> bool; // submits nothing, for draining what is in flight
+        auto PeekCQE(std::uint64_t& nUserData, std::int32_t& nResult) -> bool;
+        auto PopUnsubmitted(std::uint64_t& nUserData) -> bool; // takes back the newest SQE the kernel has not consumed yet
+
+    public:
+        static auto PrepOpenAt(io_uring_sqe* pSQE, const int nDirFD, const char* cpPath, const int nFlags, const std::uint64_t nUserData) -> void;
+        static auto PrepStatx(io_uring_sqe* pSQE, const int nDirFD, const char* cpPath, const int nFlags, const unsigned nMask, struct statx* pStatx, const std::uint64_t nUserData) -> void;
+        static auto PrepUnlinkAt(io_uring_sqe* pSQE, const int nDirFD, const char* cpPath, const int nFlags, const std::uint64_t nUserData) -> void;
+        static auto PrepRenameAt(io_uring_sqe* pSQE, const int nOldDirFD, const char* cpOldPath, const int nNewDirFD, const char* cpNewPath, const unsigned nFlags, const std::uint64_t nUserData) -> void;
+    };
+} // namespace ZQF::Zut::ZxFS::Plat
+#endif
@@ -1,6 +1,11 @@
 #include "Walker.h"
 #include "Core.h"
 #include "Plat.h"
+#include "Probe.h"
+#include "Scratch.h"
+#include <string>
+#include <memory>
+#include <algorithm>
 #include <stdexcept>
 
 
@@ -13,33 +18,35 @@ namespace ZQF::Zut::ZxFS
 {
     constexpr auto PATH_MAX_BYTES = 0x1000;
 
-    Walker::Walker(const std::string_view msWalkDir)
+    Walker::Walker(const std::string_view msWalkDir, const std::uint32_t nStatFields, const std::size_t nMaxDepth) : m_nStatFields{ nStatFields }, m_nMaxDepth{ nMaxDepth }
     {
         if (!msWalkDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxPath::Walk::Walk(): walk dir format error! -> " }.append(msWalkDir)); }
 
-        m_upCache = std::make_unique_for_overwrite<char[]>(PATH_MAX_BYTES);
-
-        wchar_t* wide_path = reinterpret_cast<wchar_t*>(m_upCache.get());
-        const auto wide_path_char_cnt = Plat::PathUTF8ToWide(msWalkDir, wide_path, PATH_MAX_BYTES / sizeof(wchar_t));
+        m_msCache = Scratch::Take();
+        wchar_t* wide_path = reinterpret_cast<wchar_t*>(Scratch::Fit(m_msCache, std::max<std::size_t>(PATH_MAX_BYTES, (msWalkDir.size() + 2) * sizeof(wchar_t))));
+        const auto wide_path_char_cnt = Plat::PathUTF8ToWide(msWalkDir, wide_path, m_msCache.size() / sizeof(wchar_t));
         wide_path[wide_path_char_cnt + 0] = L'*';
         wide_path[wide_path_char_cnt + 1] = L'\0';
 
         WIN32_FIND_DATAW find_data;
-        const auto hfind = ::FindFirstFileExW(wide_path, FindExInfoBasic, &find_data, FindExSearchNameMatch, nullptr, 0);
+        const auto hfind = ZXFS_STAT_CALL(OpenDir, ::FindFirstFileExW(wide_path, FindExInfoBasic, &find_data, FindExSearchNameMatch, nullptr, 0));
         if (hfind == INVALID_HANDLE_VALUE) { throw std::runtime_error(std::string{ "ZxPath::Walk::Walk(): walk dir open error! -> " }.append(msWalkDir)); }
+        ZXFS_STAT_INC(DirVisited);
         m_hFind = reinterpret_cast<std::uintptr_t>(hfind);
 
-        std::memcpy(m_upCache.get(), msWalkDir.data(), msWalkDir.size() * sizeof(char));
-        m_upCache[msWalkDir.size()] = {};
+        std::memcpy(m_msCache.data(), msWalkDir.data(), msWalkDir.size() * sizeof(char));
+        m_msCache[msWalkDir.size()] = {};
         m_nWalkDirBytes = msWalkDir.size() * sizeof(char);
     }
 
     Walker::~Walker()
     {
         ::FindClose(reinterpret_cast<HANDLE>(m_hFind));
+        for (const auto& frame : m_vcDirFrames) { ::FindClose(reinterpret_cast<HANDLE>(frame.FindHandle)); }
+        Scratch::Give(std::move(m_msCache));
     }
 
-    auto Walker::NextDir() -> bool
+    auto Walker::ReadEntry() -> bool
     {
         WIN32_FIND_DATAW find_data;
         while (::FindNextFileW(reinterpret_cast<HANDLE>(m_hFind), &find_data))
@@ -47,81 +54,170 @@ namespace ZQF::Zut::ZxFS
             if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
             if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
 
-            if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            ZXFS_STAT_INC(EntrySeen);
+            const std::wstring_view name_w{ find_data.cFileName };
+            const auto needed_bytes{ m_nWalkDirBytes + name_w.size() * 3 + 2 }; // a utf-16 unit is at most 3 utf-8 bytes, plus the '/' and '\0' of StoreName
+            if (needed_bytes > m_msCache.size()) // only a deep recursive walk outgrows PATH_MAX
             {
-                auto name_bytes = Plat::PathWideToUTF8({ find_data.cFileName }, m_upCache.get() + m_nWalkDirBytes, PATH_MAX_BYTES - m_nWalkDirBytes);
-                if ((name_bytes + 1) >= PATH_MAX_BYTES) { return false; }
-                m_upCache[m_nWalkDirBytes + name_bytes + 0] = '/';
-                m_upCache[m_nWalkDirBytes + name_bytes + 1] = '\0';
-                m_nNameBytes = name_bytes + 1;
-                return true;
+                Scratch::Fit(m_msCache, std::max(m_msCache.size() * 2, needed_bytes));
             }
+            const auto name_bytes = Plat::PathWideToUTF8(name_w, m_msCache.data() + m_nWalkDirBytes, m_msCache.size() - m_nWalkDirBytes);
+
+            const auto size{ (static_cast<std::uint64_t>(find_data.nFileSizeHigh) << 32) | find_data.nFileSizeLow };
+            const auto write_time{ (static_cast<std::uint64_t>(find_data.ftLastWriteTime.dwHighDateTime) << 32) | find_data.ftLastWriteTime.dwLowDateTime };
+            m_Entry.Bind({ m_msCache.data() + m_nWalkDirBytes, name_bytes }, find_data.dwFileAttributes, size, write_time);
+            return true;
         }
 
         return false;
     }
 
-    auto Walker::NextFile() -> bool
+    auto Walker::StoreName() -> void
+    {
+        m_nNameBytes = m_Entry.GetName().size();
+        if (m_Entry.IsDir()) { m_msCache[m_nWalkDirBytes + m_nNameBytes++] = '/'; }
+        m_msCache[m_nWalkDirBytes + m_nNameBytes] = '\0';
+    }
+
+    auto Walker::EnterDir() -> bool
     {
+        auto search_path_w{ std::wstring{ Plat::PathUTF8ToWide({ m_msCache.data(), m_nWalkDirBytes + m_nNameBytes }).first } };
+        search_path_w.push_back(L'*');
+
         WIN32_FIND_DATAW find_data;
-        while (::FindNextFileW(reinterpret_cast<HANDLE>(m_hFind), &find_data))
-        {
-            if ((*reinterpret_cast<std::uint32_t*>(find_data.cFileName)) == std::uint32_t(0x0000002E)) { continue; } // skip .
-            if (((*reinterpret_cast<std::uint64_t*>(find_data.cFileName)) & 0x000000FFFFFFFFFF) == std::uint64_t(0x00000000002E002E)) { continue; } // skip ..
+        const auto hfind = ZXFS_STAT_CALL(OpenDir, ::FindFirstFileExW(search_path_w.c_str(), FindExInfoBasic, &find_data, FindExSearchNameMatch, nullptr, 0));
+        if (hfind == INVALID_HANDLE_VALUE) { return false; }
+        ZXFS_STAT_INC(DirVisited);
 
-            if (!(find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
-            {
-                m_nNameBytes = Plat::PathWideToUTF8(find_data.cFileName, m_upCache.get() + m_nWalkDirBytes, PATH_MAX_BYTES - m_nWalkDirBytes);
-                return true;
-            }
-        }
+        m_vcDirFrames.emplace_back(DirFrame{ .FindHandle = m_hFind, .WalkDirBytes = m_nWalkDirBytes });
+        m_hFind = reinterpret_cast<std::uintptr_t>(hfind);
+        m_nWalkDirBytes += m_nNameBytes;
+        m_nNameBytes = 0;
+        return true;
+    }
 
-        return false;
+    auto Walker::LeaveDir() -> void
+    {
+        ::FindClose(reinterpret_cast<HANDLE>(m_hFind));
+        m_hFind = m_vcDirFrames.back().FindHandle;
+        m_nWalkDirBytes = m_vcDirFrames.back().WalkDirBytes;
+        m_nNameBytes = 0;
+        m_vcDirFrames.pop_back();
     }
 } // namespace ZQF::Zut::ZxFS
 #elif __linux__
 #include <unistd.h>
-#include <fcntl.h>
 #include <dirent.h>
-#include <sys/stat.h>
 #include <cstring>
 
 
 namespace ZQF::Zut::ZxFS
 {
-    Walker::Walker(const std::string_view msWalkDir)
+    Walker::Walker(const std::string_view msWalkDir, const std::uint32_t nStatFields, const std::size_t nMaxDepth) : m_nStatFields{ nStatFields }, m_nMaxDepth{ nMaxDepth }
     {
         if (!msWalkDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxPath::Walker::Walker: walk dir format error! -> " }.append(msWalkDir)); }
 
-        const auto dir_ptr = ::opendir(msWalkDir.data());
-        if (dir_ptr == nullptr) { throw std::runtime_error(std::string{ "ZxPath::Walker::Walker: walk dir open error! -> " }.append(msWalkDir)); }
-        m_hFind = reinterpret_cast<std::uintptr_t>(dir_ptr);
+        auto dir_reader = std::make_unique<Plat::DirReader>();
+        if (dir_reader->Open(msWalkDir.data()) == false) { throw std::runtime_error(std::string{ "ZxPath::Walker::Walker: walk dir open error! -> " }.append(msWalkDir)); }
+        m_hFind = reinterpret_cast<std::uintptr_t>(dir_reader.release());
 
         const auto path_max_byte = ::pathconf(".", _PC_PATH_MAX);
-        m_upCache = std::make_unique_for_overwrite<char[]>(path_max_byte == -1 ? 1024 : path_max_byte);
+        m_msCache = Scratch::Take();
+        Scratch::Fit(m_msCache, std::max<std::size_t>(path_max_byte == -1 ? 1024 : static_cast<std::size_t>(path_max_byte), msWalkDir.size() + 1));
         m_nWalkDirBytes = msWalkDir.size() * sizeof(char);
-        std::memcpy(m_upCache.get(), msWalkDir.data(), m_nWalkDirBytes);
-        m_upCache[m_nWalkDirBytes] = '\0';
+        std::memcpy(m_msCache.data(), msWalkDir.data(), m_nWalkDirBytes);
+        m_msCache[m_nWalkDirBytes] = '\0';
     }
 
     Walker::~Walker()
     {
-        ::closedir(reinterpret_cast<DIR*>(m_hFind));
+        delete reinterpret_cast<Plat::DirReader*>(m_hFind);
+        for (const auto& frame : m_vcDirFrames) { delete reinterpret_cast<Plat::DirReader*>(frame.FindHandle); }
+        Scratch::Give(std::move(m_msCache));
+    }
+
+    auto Walker::ReadEntry() -> bool
+    {
+        const auto dir_reader = reinterpret_cast<Plat::DirReader*>(m_hFind);
+        if (dir_reader->Next() == false) { return false; }
+        m_Entry.Bind(dir_reader->GetFD(), dir_reader->GetName(), dir_reader->GetType(), dir_reader->GetIno(), m_nStatFields);
+        return true;
+    }
+
+    auto Walker::StoreName() -> void
+    {
+        const auto name = m_Entry.GetName();
+        if (m_nWalkDirBytes + name.size() + 2 > m_msCache.size()) // only a deep recursive walk outgrows PATH_MAX
+        {
+            Scratch::Fit(m_msCache, std::max(m_msCache.size() * 2, m_nWalkDirBytes + name.size() + 2));
+        }
+        std::memcpy(m_msCache.data() + m_nWalkDirBytes, name.data(), name.size());
+        m_nNameBytes = name.size();
+        if (m_Entry.IsDir()) { m_msCache[m_nWalkDirBytes + m_nNameBytes++] = '/'; }
+        m_msCache[m_nWalkDirBytes + m_nNameBytes] = '\0';
+    }
+
+    auto Walker::EnterDir() -> bool
+    {
+        const auto parent_reader = reinterpret_cast<Plat::DirReader*>(m_hFind);
+        auto dir_reader = std::make_unique<Plat::DirReader>();
+        m_msCache[m_nWalkDirBytes + m_nNameBytes - 1] = '\0'; // openat by bare name, relative to the parent
+        const auto status{ dir_reader->Open(parent_reader->GetFD(), m_msCache.data() + m_nWalkDirBytes) };
+        m_msCache[m_nWalkDirBytes + m_nNameBytes - 1] = '/';
+        if (status == false) { return false; }
+
+        m_vcDirFrames.emplace_back(DirFrame{ .FindHandle = m_hFind, .WalkDirBytes = m_nWalkDirBytes });
+        m_hFind = reinterpret_cast<std::uintptr_t>(dir_reader.release());
+        m_nWalkDirBytes += m_nNameBytes;
+        m_nNameBytes = 0;
+        return true;
+    }
+
+    auto Walker::LeaveDir() -> void
+    {
+        delete reinterpret_cast<Plat::DirReader*>(m_hFind);
+        m_hFind = m_vcDirFrames.back().FindHandle;
+        m_nWalkDirBytes = m_vcDirFrames.back().WalkDirBytes;
+        m_nNameBytes = 0;
+        m_vcDirFrames.pop_back();
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
+
+namespace ZQF::Zut::ZxFS
+{
+    // opens the directory returned last when it was not pruned, climbs back up once a level is exhausted
+    auto Walker::ReadEntryRecursive() -> bool
+    {
+        while (true)
+        {
+            if (m_isDescendPending)
+            {
+                m_isDescendPending = false;
+                this->EnterDir(); // an unreadable directory is skipped
+            }
+
+            if (this->ReadEntry()) { return true; }
+            if (m_vcDirFrames.empty()) { return false; }
+            this->LeaveDir();
+        }
+    }
+
+    auto Walker::Next() -> bool
+    {
+        if (this->ReadEntryRecursive() == false) { return false; }
+        this->StoreName();
+        m_isDescendPending = (m_vcDirFrames.size() < m_nMaxDepth) && m_Entry.IsDir();
+        return true;
     }
 
     auto Walker::NextDir() -> bool
     {
-        while (const auto entry_ptr = ::readdir(reinterpret_cast<DIR*>(m_hFind)))
+        while (this->ReadEntryRecursive())
         {
-            if ((*reinterpret_cast<std::uint16_t*>(entry_ptr->d_name)) == std::uint32_t(0x002E)) { continue; }
-            if (((*reinterpret_cast<std::uint32_t*>(entry_ptr->d_name)) & 0x00FFFFFF) == std::uint32_t(0x00002E2E)) { continue; }
-            if (entry_ptr->d_type != DT_DIR) { continue; }
-
-            const auto name_bytes = std::strlen(entry_ptr->d_name);
-            std::memcpy(m_upCache.get() + m_nWalkDirBytes, entry_ptr->d_name, name_bytes);
-            m_upCache[m_nWalkDirBytes + m_nNameBytes + 0] = '/';
-            m_upCache[m_nWalkDirBytes + m_nNameBytes + 1] = '\0';
-            m_nNameBytes = name_bytes + 1;
+            if (m_Entry.IsDir() == false) { ZXFS_STAT_INC(EntrySkipped); continue; }
+            this->StoreName();
+            m_isDescendPending = m_vcDirFrames.size() < m_nMaxDepth;
             return true;
         }
 
@@ -130,28 +226,43 @@ namespace ZQF::Zut::ZxFS
 
     auto Walker::NextFile() -> bool
     {
-        while (const auto entry_ptr = ::readdir(reinterpret_cast<DIR*>(m_hFind)))
+        while (this->ReadEntryRecursive())
         {
-            if ((*reinterpret_cast<std::uint16_t*>(entry_ptr->d_name)) == std::uint32_t(0x002E)) { continue; }
-            if (((*reinterpret_cast<std::uint32_t*>(entry_ptr->d_name)) & 0x00FFFFFF) == std::uint32_t(0x00002E2E)) { continue; }
-            if (entry_ptr->d_type != DT_REG) { continue; }
+            if (m_Entry.IsFile())
+            {
+                this->StoreName();
+                return true;
+            }
 
-            m_nNameBytes = std::strlen(entry_ptr->d_name);
-            std::memcpy(m_upCache.get() + m_nWalkDirBytes, entry_ptr->d_name, m_nNameBytes);
-            m_upCache[m_nWalkDirBytes + m_nNameBytes] = {};
-            return true;
+            if ((m_vcDirFrames.size() < m_nMaxDepth) && m_Entry.IsDir())
+            {
+                this->StoreName(); // still walked into, only not returned
+                m_isDescendPending = true;
+            }
+            ZXFS_STAT_INC(EntrySkipped);
         }
 
         return false;
     }
-} // namespace ZQF::Zut::ZxFS
-#endif
 
-namespace ZQF::Zut::ZxFS
-{
+    auto Walker::Prune() -> void
+    {
+        m_isDescendPending = false;
+    }
+
+    auto Walker::GetDepth() const -> std::size_t
+    {
+        return m_vcDirFrames.size();
+    }
+
+    auto Walker::GetEntry() -> Entry&
+    {
+        return m_Entry;
+    }
+
     auto Walker::GetName() const -> std::string_view
     {
-        return { m_upCache.get() + m_nWalkDirBytes, m_nNameBytes };
+        return { m_msCache.data() + m_nWalkDirBytes, m_nNameBytes };
     }
 
     auto Walker::GetNameStem() const -> std::string_view
@@ -161,16 +272,20 @@ namespace ZQF::Zut::ZxFS
 
     auto Walker::GetPath() const -> std::string_view
     {
-        return { m_upCache.get(), m_nWalkDirBytes + m_nNameBytes };
+        return { m_msCache.data(), m_nWalkDirBytes + m_nNameBytes };
     }
 
     auto Walker::GetWalkDir() const->std::string_view
     {
-        return { m_upCache.get(), m_nWalkDirBytes };
+        return { m_msCache.data(), m_nWalkDirBytes };
     }
 
     auto Walker::IsSuffix(const std::string_view msSuffix) const -> bool
     {
-        return ZxFS::FileSuffix(this->GetName()) == msSuffix ? true : false;
+        // same result as FileSuffix(GetName()) == msSuffix, but a single tail compare instead of a reverse scan per entry
+        const auto name{ this->GetName() };
+        if (msSuffix.empty()) { return ZxFS::FileSuffix(name).empty(); }
+        if ((msSuffix.front() != '.') || (msSuffix.find_first_of("./", 1) != std::string_view::npos)) { return false; }
+        return name.ends_with(msSuffix);
     }
 } // namespace ZQF::Zut::ZxFS
@@ -1,21 +1,43 @@
 #pragma once
 #include <cstdint>
-#include <memory>
+#include <string>
+#include <vector>
 #include <string_view>
+#include <Zut/ZxFS/Entry.h>
 
 
 namespace ZQF::Zut::ZxFS
 {
+    // with nMaxDepth > 0 the walk is recursive (depth first): a directory returned by Next / NextDir / NextFile skips it
+    // is opened on the following call, entries below it are up to nMaxDepth levels under msWalkDir. every level shares
+    // one path buffer (reused across walkers of a thread), GetWalkDir is the directory of the current entry.
     class Walker
     {
+    public:
+        static constexpr std::size_t ANY_DEPTH{ ~std::size_t{} };
+
+    private:
+        struct DirFrame
+        {
+            std::uintptr_t FindHandle{};
+            std::size_t WalkDirBytes{};
+        };
+
     private:
         std::uintptr_t m_hFind{};
-        std::unique_ptr<char[]> m_upCache{};
+        std::string m_msCache; // path buffer, its size is the usable capacity. taken from and given back to the thread's scratch free list
         std::size_t m_nNameBytes{};
         std::size_t m_nWalkDirBytes{};
+        std::uint32_t m_nStatFields{};
+        std::size_t m_nMaxDepth{};
+        bool m_isDescendPending{};
+        std::vector<DirFrame> m_vcDirFrames; // parents of the directory being read
+        Entry m_Entry;
 
     public:
-        Walker(const std::string_view msWalkDir);
+        Walker(const std::string_view msWalkDir, const std::uint32_t nStatFields = EntryField::None, const std::size_t nMaxDepth = 0);
+        Walker(const Walker&) = delete;
+        auto operator=(const Walker&) -> Walker& = delete;
         ~Walker();
 
     public:
@@ -23,10 +45,21 @@ namespace ZQF::Zut::ZxFS
         auto GetName() const->std::string_view;
         auto GetNameStem() const->std::string_view;
         auto GetWalkDir() const->std::string_view;
+        auto GetDepth() const -> std::size_t; // 0 for entries of msWalkDir itself
+        auto GetEntry() -> Entry&; // current entry, nStatFields chooses what its first lazy stat fetches
 
     public:
+        auto Next() -> bool; // any entry, dir names get a trailing '/'
         auto NextDir() -> bool;
         auto NextFile() -> bool;
+        auto Prune() -> void; // recursive walk: do not open the directory just returned (e.g. .git/, node_modules/)
         auto IsSuffix(const std::string_view msSuffix) const -> bool;
+
+    private:
+        auto ReadEntry() -> bool;
+        auto ReadEntryRecursive() -> bool;
+        auto StoreName() -> void;
+        auto EnterDir() -> bool;
+        auto LeaveDir() -> void;
     };
 } // namespace ZQF::Zut::ZxFS
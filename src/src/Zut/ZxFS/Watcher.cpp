@@ -0,0 +1,306 @@
+#include "Watcher.h"
+#include "Walker.h"
+#include "Core.h"
+#include <stdexcept>
+
+
+#ifdef _WIN32
+namespace ZQF::Zut::ZxFS
+{
+    Watcher::Watcher(const std::string_view msBaseDir) : m_msBaseDir{ msBaseDir }
+    {
+        if (!msBaseDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxFS::Watcher::Watcher(): dir format error! -> " }.append(msBaseDir)); }
+        if ((this->Resync() == false) && (this->ContainsDir("") == false)) { throw std::runtime_error(std::string{ "ZxFS::Watcher::Watcher(): dir open error! -> " }.append(msBaseDir)); }
+    }
+
+    Watcher::~Watcher()
+    {
+
+    }
+
+    auto Watcher::Poll(const int /* nTimeoutMS */) -> std::size_t
+    {
+        this->Resync();
+        return 0;
+    }
+
+    auto Watcher::Reset() -> void
+    {
+        m_mpWatchDirs.clear();
+        m_mpDirs.clear();
+        m_nFileCount = 0;
+    }
+} // namespace ZQF::Zut::ZxFS
+#elif __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <sys/inotify.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    constexpr std::uint32_t WATCH_MASK{ IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_DONT_FOLLOW | IN_EXCL_UNLINK | IN_ONLYDIR };
+
+    Watcher::Watcher(const std::string_view msBaseDir) : m_msBaseDir{ msBaseDir }
+    {
+        if (!msBaseDir.ends_with('/')) { throw std::runtime_error(std::string{ "ZxFS::Watcher::Watcher(): dir format error! -> " }.append(msBaseDir)); }
+        m_nNotifyFD = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_nNotifyFD == -1) { throw std::runtime_error("ZxFS::Watcher::Watcher(): inotify_init1 error!"); }
+        if ((this->Resync() == false) && (this->ContainsDir("") == false)) { ::close(m_nNotifyFD); throw std::runtime_error(std::string{ "ZxFS::Watcher::Watcher(): dir open error! -> " }.append(msBaseDir)); }
+    }
+
+    Watcher::~Watcher()
+    {
+        if (m_nNotifyFD != -1) { ::close(m_nNotifyFD); }
+    }
+
+    auto Watcher::Poll(const int nTimeoutMS) -> std::size_t
+    {
+        pollfd poll_fd{ m_nNotifyFD, POLLIN, 0 };
+        if (::poll(&poll_fd, 1, nTimeoutMS) <= 0) { return 0; }
+
+        alignas(inotify_event) char event_buffer[0x10000];
+        std::size_t event_count{};
+
+        while (true)
+        {
+            const auto read_bytes{ ::read(m_nNotifyFD, event_buffer, sizeof(event_buffer)) };
+            if (read_bytes <= 0) { break; } // EAGAIN: drained
+
+            for (ssize_t event_pos{}; event_pos < read_bytes; )
+            {
+                const auto event_ptr{ reinterpret_cast<const inotify_event*>(event_buffer + event_pos) };
+                event_pos += static_cast<ssize_t>(sizeof(inotify_event) + event_ptr->len);
+                event_count++;
+
+                if (event_ptr->mask & IN_Q_OVERFLOW) { this->Resync(); return event_count; }
+
+                const auto watch_ite{ m_mpWatchDirs.find(event_ptr->wd) };
+                if (watch_ite == m_mpWatchDirs.end()) { continue; }
+
+                if (event_ptr->mask & IN_IGNORED) { m_mpWatchDirs.erase(watch_ite); continue; }
+
+                const auto dir_name{ watch_ite->second };
+                if (event_ptr->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+                {
+                    // the base dir itself went away, sub directories are handled through their parents
+                    if (dir_name.empty()) { this->Reset(); }
+                    continue;
+                }
+
+                const std::string_view entry_name{ event_ptr->name };
+                if (event_ptr->mask & IN_ISDIR)
+                {
+                    const auto sub_dir_name{ std::string{ dir_name }.append(entry_name).append(1, '/') };
+                    if (event_ptr->mask & (IN_CREATE | IN_MOVED_TO)) { this->AddTree(sub_dir_name); }
+                    else if (event_ptr->mask & (IN_DELETE | IN_MOVED_FROM)) { this->RemoveTree(sub_dir_name); }
+                }
+                else
+                {
+                    if (event_ptr->mask & (IN_CREATE | IN_MOVED_TO)) { this->AddFile(dir_name, entry_name); }
+                    else if (event_ptr->mask & (IN_DELETE | IN_MOVED_FROM)) { this->RemoveFile(dir_name, entry_name); }
+                }
+            }
+        }
+
+        return event_count;
+    }
+
+    auto Watcher::Reset() -> void
+    {
+        for (const auto& [watch_fd, dir_name] : m_mpWatchDirs) { ::inotify_rm_watch(m_nNotifyFD, watch_fd); }
+        m_mpWatchDirs.clear();
+        m_mpDirs.clear();
+        m_nFileCount = 0;
+
+        // drop whatever is still queued for the old watches
+        char event_buffer[0x1000];
+        while (::read(m_nNotifyFD, event_buffer, sizeof(event_buffer)) > 0) {}
+    }
+} // namespace ZQF::Zut::ZxFS
+#endif
+
+
+namespace ZQF::Zut::ZxFS
+{
+    auto Watcher::Resync() -> bool
+    {
+        this->Reset();
+        m_nResyncCount++;
+        m_isComplete = true;
+        return this->AddTree("");
+    }
+
+    auto Watcher::AddTree(const std::string& msRelativeDir) -> bool
+    {
+        // the watch goes on before the listing, so an entry created in between shows up either as an event or in the listing (or both, which is harmless).
+        // a dir that vanished in between is skipped, its parent's event removes it. any other error leaves the index incomplete
+        bool is_complete{ true };
+        std::vector<std::string> dir_stack{ msRelativeDir };
+        while (!dir_stack.empty())
+        {
+            const auto dir_name{ std::move(dir_stack.back()) }; dir_stack.pop_back();
+            const auto dir_path{ std::string{ m_msBaseDir }.append(dir_name) };
+
+#ifdef __linux__
+            const auto watch_fd{ ::inotify_add_watch(m_nNotifyFD, dir_path.c_str(), WATCH_MASK) };
+            if (watch_fd == -1)
+            {
+                if (dir_name.empty() || ((errno != ENOENT) && (errno != ENOTDIR))) { is_complete = false; } // ENOSPC: out of fs.inotify.max_user_watches
+                continue;
+            }
+            m_mpWatchDirs[watch_fd] = dir_name;
+#endif
+            m_mpDirs.try_emplace(dir_name);
+
+            try
+            {
+                for (ZxFS::Walker walk{ dir_path }; walk.Next(); )
+                {
+                    if (walk.GetEntry().IsDir())
+                    {
+                        dir_stack.emplace_back(std::string{ dir_name }.append(walk.GetName()));
+                    }
+                    else
+                    {
+                        this->AddFile(dir_name, walk.GetEntry().GetName());
+                    }
+                }
+            }
+            catch (const std::exception&)
+            {
+                // the index must not claim to know a dir it could not list
+                const auto dir_ite{ m_mpDirs.find(dir_name) };
+                m_nFileCount -= dir_ite->second.size();
+                m_mpDirs.erase(dir_ite);
+#ifdef __linux__
+                ::inotify_rm_watch(m_nNotifyFD, watch_fd);
+                m_mpWatchDirs.erase(watch_fd);
+#endif
+                if (dir_name.empty() || ZxFS::Exist(dir_path)) { is_complete = false; } // the base dir vanishing is not skipped
+            }
+        }
+
+        if (is_complete == false) { m_isComplete = false; }
+        return is_complete;
+    }
+
+    auto Watcher::RemoveTree(const std::string& msRelativeDir) -> void
+    {
+        for (auto ite{ m_mpDirs.begin() }; ite != m_mpDirs.end(); )
+        {
+            if (ite->first.starts_with(msRelativeDir))
+            {
+                m_nFileCount -= ite->second.size();
+                ite = m_mpDirs.erase(ite);
+            }
+            else
+            {
+                ++ite;
+            }
+        }
+
+        // a moved-out directory keeps its watches, drop them so its new location does not feed this index
+        for (auto ite{ m_mpWatchDirs.begin() }; ite != m_mpWatchDirs.end(); )
+        {
+            if (ite->second.starts_with(msRelativeDir))
+            {
+#ifdef __linux__
+                ::inotify_rm_watch(m_nNotifyFD, ite->first);
+#endif
+                ite = m_mpWatchDirs.erase(ite);
+            }
+            else
+            {
+                ++ite;
+            }
+        }
+    }
+
+    auto Watcher::AddFile(const std::string& msRelativeDir, const std::string_view msName) -> void
+    {
+        const auto dir_ite{ m_mpDirs.find(msRelativeDir) };
+        if (dir_ite == m_mpDirs.end()) { return; }
+        if (dir_ite->second.emplace(msName).second) { m_nFileCount++; }
+    }
+
+    auto Watcher::RemoveFile(const std::string& msRelativeDir, const std::string_view msName) -> void
+    {
+        const auto dir_ite{ m_mpDirs.find(msRelativeDir) };
+        if (dir_ite == m_mpDirs.end()) { return; }
+        if (dir_ite->second.erase(std::string{ msName }) != 0) { m_nFileCount--; }
+    }
+
+    auto Watcher::Contains(const std::string_view msRelativePath) const -> bool
+    {
+        const auto name_pos{ msRelativePath.rfind('/') };
+        const auto dir_name{ name_pos == std::string_view::npos ? std::string_view{} : msRelativePath.substr(0, name_pos + 1) };
+        const auto file_name{ name_pos == std::string_view::npos ? msRelativePath : msRelativePath.substr(name_pos + 1) };
+
+        const auto dir_ite{ m_mpDirs.find(std::string{ dir_name }) };
+        return (dir_ite != m_mpDirs.end()) && dir_ite->second.contains(std::string{ file_name });
+    }
+
+    auto Watcher::ContainsDir(const std::string_view msRelativeDir) const -> bool
+    {
+        return m_mpDirs.contains(std::string{ msRelativeDir });
+    }
+
+    template <typename PathContainer>
+    static auto WatcherFilePaths(PathContainer& vcPaths, const std::string_view msBaseDir, const std::unordered_map<std::string, std::unordered_set<std::string>>& mpDirs, const bool isWithDir) -> void
+    {
+        std::string path_cache{ isWithDir ? msBaseDir : std::string_view{} };
+        const auto prefix_bytes{ path_cache.size() };
+
+        for (const auto& [dir_name, file_names] : mpDirs)
+        {
+            path_cache.resize(prefix_bytes);
+            path_cache.append(dir_name);
+            const auto dir_path_bytes{ path_cache.size() };
+
+            for (const auto& file_name : file_names)
+            {
+                path_cache.resize(dir_path_bytes);
+                path_cache.append(file_name);
+                vcPaths.emplace_back(std::string_view{ path_cache });
+            }
+        }
+    }
+
+    auto Watcher::GetFilePaths(std::vector<std::string>& vcPaths, const bool isWithDir) const -> void
+    {
+        vcPaths.reserve(vcPaths.size() + m_nFileCount);
+        ZxFS::WatcherFilePaths(vcPaths, m_msBaseDir, m_mpDirs, isWithDir);
+    }
+
+    auto Watcher::GetFilePaths(PathList& vcPaths, const bool isWithDir) const -> void
+    {
+        ZxFS::WatcherFilePaths(vcPaths, m_msBaseDir, m_mpDirs, isWithDir);
+    }
+
+    auto Watcher::GetBaseDir() const -> std::string_view
+    {
+        return m_msBaseDir;
+    }
+
+    auto Watcher::GetFileCount() const -> std::size_t
+    {
+        return m_nFileCount;
+    }
+
+    auto Watcher::GetDirCount() const -> std::size_t
+    {
+        return m_mpDirs.size();
+    }
+
+    auto Watcher::GetResyncCount() const -> std::size_t
+    {
+        return m_nResyncCount;
+    }
+
+    auto Watcher::IsComplete() const -> bool
+    {
+        return m_isComplete;
+    }
+} // namespace ZQF::Zut::ZxFS
@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <Zut/ZxFS/PathList.h>
+
+
+namespace ZQF::Zut::ZxFS
+{
+    // in-memory file index of a tree, seeded by one scan and then kept current from inotify events.
+    // not thread safe, the owner drives it with Poll(). on windows there is no event source yet, Poll() rescans.
+    class Watcher
+    {
+    private:
+        int m_nNotifyFD{ -1 };
+        std::string m_msBaseDir;
+        std::unordered_map<int, std::string> m_mpWatchDirs;                        // watch descriptor -> dir path relative to the base dir
+        std::unordered_map<std::string, std::unordered_set<std::string>> m_mpDirs; // dir path relative to the base dir -> file names
+        std::size_t m_nFileCount{};
+        std::size_t m_nResyncCount{};
+        bool m_isComplete{ true };
+
+    public:
+        Watcher(const std::string_view msBaseDir);
+        Watcher(const Watcher&) = delete;
+        auto operator=(const Watcher&) -> Watcher& = delete;
+        ~Watcher();
+
+    public:
+        auto Poll(const int nTimeoutMS) -> std::size_t; // applies pending events, returns the count, waits up to nTimeoutMS for the first one
+        auto Resync() -> bool;                          // drop everything and rescan, also done on event queue overflow. false if the tree is not fully indexed
+
+    public:
+        auto Contains(const std::string_view msRelativePath) const -> bool;
+        auto ContainsDir(const std::string_view msRelativeDir) const -> bool; // "" or "a/b/"
+        auto GetFilePaths(std::vector<std::string>& vcPaths, const bool isWithDir) const -> void;
+        auto GetFilePaths(PathList& vcPaths, const bool isWithDir) const -> void;
+        auto GetBaseDir() const -> std::string_view;
+        auto GetFileCount() const -> std::size_t;
+        auto GetDirCount() const -> std::size_t;
+        auto GetResyncCount() const -> std::size_t; // including the initial seed
+        auto IsComplete() const -> bool;            // false once a directory could not be watched or listed (not just vanished), until the next successful Resync()
+
+    private:
+        auto AddTree(const std::string& msRelativeDir) -> bool;
+        auto RemoveTree(const std::string& msRelativeDir) -> void;
+        auto AddFile(const std::string& msRelativeDir, const std::string_view msName) -> void;
+        auto RemoveFile(const std::string& msRelativeDir, const std::string_view msName) -> void;
+        auto Reset() -> void;
+    };
+} // namespace ZQF::Zut::ZxFS
@@ -2,6 +2,7 @@
 #include <cassert>
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 #include <filesystem>
 #include <Zut/ZxFS.h>
 
@@ -132,6 +133,17 @@ auto main() -> int
         auto fle_suffix_8 = ZxFS::FileSuffix(path_8);
         MyAssert(fle_suffix_8 == ".");
 
+        static_assert(ZxFS::FileNameStem("dirx/asfas.d/123.jpg") == "123");
+        static_assert(ZxFS::FileSuffix("dirx/asfas.d/123") == "");
+        ZxFS::PathList split_paths;
+        split_paths.emplace_back(path_0);
+        split_paths.emplace_back("a_long_directory_name.dir/and_a_long_file_name.tar.gz");
+        std::vector<ZxFS::PathComponents> split_components;
+        ZxFS::PathSplit(split_paths, split_components);
+        MyAssert(split_components.size() == 2);
+        MyAssert(split_paths[0].substr(split_components[0].NameBeg) == file_name_0 && split_paths[0].substr(split_components[0].SuffixBeg) == fle_suffix_0);
+        MyAssert(split_paths[1].substr(split_components[1].NameBeg, split_components[1].SuffixBeg - split_components[1].NameBeg) == "and_a_long_file_name.tar");
+
 
         auto [self_dir_sv, self_dir_buf] = ZxFS::SelfDir();
         auto [self_path_sv, self_path_buf] = ZxFS::SelfPath();
@@ -156,6 +168,15 @@ auto main() -> int
         bool copy_status_1 = ZxFS::FileCopy(self_path_sv, "test.bin", true);
         MyAssert(copy_status_1 == false);
 
+        bool copy_status_2 = ZxFS::FileCopy(self_path_sv, "test.bin", false, ZxFS::FileCopyFlag::Sparse);
+        MyAssert(copy_status_2 == true && std::filesystem::file_size("test.bin") == std::filesystem::file_size(self_path_sv));
+        std::filesystem::permissions("test.bin", std::filesystem::perms::owner_write, std::filesystem::perm_options::remove);
+        MyAssert(ZxFS::FileCopy("test.bin", "test_ro.bin", false) && ZxFS::FileCopy("test.bin", "test_ro.bin", false)); // read-only copy overwritten
+        MyAssert((std::filesystem::status("test_ro.bin").permissions() & std::filesystem::perms::owner_write) == std::filesystem::perms::none);
+        std::filesystem::permissions("test.bin", std::filesystem::perms::owner_write, std::filesystem::perm_options::add);
+        std::filesystem::permissions("test_ro.bin", std::filesystem::perms::owner_write, std::filesystem::perm_options::add);
+        ZxFS::FileDelete("test_ro.bin");
+
         ZxFS::DirMakeRecursive("weufbuiwef/214124/41241/");
         bool move_file_status_0 = ZxFS::FileMove("test.bin", "weufbuiwef/214124/41241/test.bin");
         MyAssert(move_file_status_0 == true);
@@ -163,6 +184,15 @@ auto main() -> int
         bool move_file_status_1 = ZxFS::FileMove("weufbuiwef/214124/41241/test.bin", "test.bin");
         MyAssert(move_file_status_1 == true);
 
+        {
+            ZxFS::MappedFile mapped_self{ self_path_sv, false, ZxFS::MapHint::Sequential | ZxFS::MapHint::WillNeed };
+            ZxFS::MappedFile mapped_copy{ "test.bin", true };
+            MyAssert(mapped_self.GetSize() == mapped_copy.GetSize() && std::ranges::equal(mapped_self.GetSpan(), mapped_copy.GetSpan()));
+            MyAssert(mapped_self.GetWritableSpan().empty());
+            mapped_copy.GetWritableSpan()[0] = std::byte{ 0x5A };
+            MyAssert(mapped_copy.Flush() && ZxFS::MappedFile{ "test.bin" }.GetSpan()[0] == std::byte{ 0x5A });
+        }
+
         bool del_status = ZxFS::FileDelete("test.bin");
         MyAssert(del_status == true);
 
@@ -177,6 +207,188 @@ auto main() -> int
         MyAssert(dir_make_recursive_status == true);
         MyAssert(ZxFS::Exist("123/41245/215/125/1251/"));
         ZxFS::DirDeleteRecursive("123/");
+        std::vector<std::string> dir_make_paths{ "123/a/", "123/a/b/", "123//a/c/" };
+        for (std::size_t index{}; index < 300; index++) { dir_make_paths.emplace_back("123/p" + std::to_string(index % 7) + "/q" + std::to_string(index) + "/"); }
+        MyAssert(ZxFS::DirMakeRecursive(dir_make_paths, 4) == true);
+        MyAssert(ZxFS::Exist("123/a/c/") && ZxFS::Exist("123/p5/q299/") && ZxFS::DirMakeRecursive(dir_make_paths, 1) == true);
+        MyAssert(ZxFS::DirMakeRecursive(std::vector<std::string>{ "123/a/", "123/a/b" }, 1) == false);
+        ZxFS::DirDeleteRecursive("123/");
+
+        ZxFS::DirMakeRecursive("searcher_test/a/b/");
+        ZxFS::FileCopy(self_path_sv, "searcher_test/a/x.bin", false);
+        ZxFS::FileCopy(self_path_sv, "searcher_test/a/b/y.bin", false);
+        auto search_serial = ZxFS::Searcher::GetFilePaths("searcher_test/", true, true);
+        auto search_parallel = ZxFS::Searcher::GetFilePaths("searcher_test/", true, true, 4);
+        auto search_async = ZxFS::Searcher::GetFilePathsAsync("searcher_test/", true, 16);
+        std::ranges::sort(search_serial);
+        std::ranges::sort(search_parallel);
+        std::ranges::sort(search_async);
+        MyAssert(search_serial.size() == 2);
+        MyAssert(search_serial == search_parallel);
+        MyAssert(search_serial == search_async);
+        {
+            ZxFS::ScanCursor scan_cursor;
+            std::vector<std::string> cursor_paths;
+            MyAssert(scan_cursor.Start("searcher_test/") && scan_cursor.Next(cursor_paths, true, 1) && cursor_paths.size() == 1);
+            MyAssert(scan_cursor.Save("searcher_test.cur"));
+            ZxFS::ScanCursor scan_cursor_loaded;
+            MyAssert(scan_cursor_loaded.Load("searcher_test.cur"));
+            while (scan_cursor_loaded.Next(cursor_paths, true, 1)) {}
+            std::ranges::sort(cursor_paths);
+            MyAssert(scan_cursor_loaded.IsDone() && cursor_paths == search_serial);
+            ZxFS::FileDelete("searcher_test.cur");
+        }
+        ZxFS::Dedupe dedupe;
+        MyAssert(dedupe.Run(search_serial, 4) && dedupe.GetGroups().size() == 1);
+        MyAssert((dedupe.GetGroups().front().Paths == std::vector<std::string>{ "searcher_test/a/b/y.bin", "searcher_test/a/x.bin" }));
+        MyAssert(dedupe.GetBytesRead() == dedupe.GetBytesTotal() + ZxFS::Dedupe::PARTIAL_BLOCK_BYTES * 4);
+        std::filesystem::create_symlink("x.bin", "searcher_test/a/x_symlink.bin");
+        MyAssert(dedupe.Run(std::vector<std::string>{ "searcher_test/a/x.bin", "searcher_test/a/x_symlink.bin" }, 4) && dedupe.GetGroups().empty() && dedupe.GetBytesTotal() == std::filesystem::file_size("searcher_test/a/x.bin"));
+        std::filesystem::remove("searcher_test/a/x_symlink.bin");
+        {
+            const std::vector<std::string> dedupe_paths{ "dedupe_0.bin", "dedupe_1.bin", "dedupe_2.bin" };
+            for (const auto& path : dedupe_paths) { MyAssert(ZxFS::FileCopy(self_path_sv, path, false)); }
+            {
+                ZxFS::MappedFile mapped_middle{ dedupe_paths[2], true };
+                auto middle_span = mapped_middle.GetWritableSpan();
+                middle_span[middle_span.size() / 2] = ~middle_span[middle_span.size() / 2]; // same size, first and last block
+                MyAssert(mapped_middle.Flush());
+            }
+            MyAssert(dedupe.Run(dedupe_paths, 4) && dedupe.GetGroups().size() == 1 && dedupe.GetGroups().front().Paths == std::vector<std::string>{ "dedupe_0.bin", "dedupe_1.bin" });
+            MyAssert(dedupe.GetBytesRead() == dedupe.GetBytesTotal() + ZxFS::Dedupe::PARTIAL_BLOCK_BYTES * 6); // every file read once in full
+            MyAssert(dedupe.Run(std::vector<std::string>{ "dedupe_0.bin", "dedupe_2.bin" }, 4) && dedupe.GetGroups().empty());
+            for (const auto& path : dedupe_paths) { ZxFS::FileDelete(path); }
+        }
+        ZxFS::PathList search_path_list;
+        ZxFS::Searcher::GetFilePaths(search_path_list, "searcher_test/", true, true);
+        auto search_path_list_vec = search_path_list.to_vector();
+        std::ranges::sort(search_path_list_vec);
+        MyAssert(search_serial == search_path_list_vec);
+        MyAssert(search_path_list[0].data()[search_path_list[0].size()] == '\0');
+        std::size_t search_visit_count{};
+        ZxFS::Searcher::VisitFilePaths("searcher_test/", true, true, [&search_visit_count](std::string_view /* msPath */) { return ++search_visit_count < 1; });
+        MyAssert(search_visit_count == 1);
+        std::vector<std::string> search_filtered;
+        ZxFS::Searcher::GetFilePaths(search_filtered, "searcher_test/", true, true, ZxFS::Filter{ { ".BIN", ".png" }, true });
+        MyAssert(search_filtered.size() == 2);
+        search_filtered.clear();
+        ZxFS::Searcher::GetFilePaths(search_filtered, "searcher_test/", false, true, 4, ZxFS::Filter{}.AddGlob("y*"));
+        MyAssert(search_filtered.size() == 1 && search_filtered[0] == "a/b/y.bin");
+        std::vector<std::string> search_dirs;
+        ZxFS::Searcher::Search<ZxFS::SearchPolicy<true, false, ZxFS::SearchType::Dir>>(search_dirs, "searcher_test/");
+        std::ranges::sort(search_dirs);
+        MyAssert((search_dirs == std::vector<std::string>{ "a/", "a/b/" }));
+        search_dirs.clear();
+        ZxFS::Searcher::Search<ZxFS::SearchPolicy<false, true, ZxFS::SearchType::All, true>>(search_dirs, "searcher_test/a/", ZxFS::Filter{}.AddGlob("?"));
+        MyAssert((search_dirs == std::vector<std::string>{ "searcher_test/a/b/" }));
+        ZxFS::Stats::Reset();
+        ZxFS::Searcher::GetFilePaths("searcher_test/", true, true);
+        const auto stats{ ZxFS::Stats::Snapshot() };
+        MyAssert(ZxFS::Stats::IsEnabled ? (stats.Counters[ZxFS::StatCounter::EntrySeen] >= 3 && stats.Counters[ZxFS::StatCounter::DirVisited] == 3) : stats.Counters[ZxFS::StatCounter::EntrySeen] == 0);
+        MyAssert(ZxFS::Stats::IsEnabled ? (stats.CallNS[ZxFS::StatCounter::ReadDir] > 0 && stats.CallNS[ZxFS::StatCounter::ReadDir] <= stats.PhaseNS[ZxFS::StatPhase::Scan]) : stats.CallNS[ZxFS::StatCounter::ReadDir] == 0);
+        MyAssert(ZxFS::Filter{ ".bin" }.IsMatch("x.BIN") == false);
+        MyAssert(ZxFS::Filter{ ".a_very_long_suffix_name" }.IsMatch("x.a_very_long_suffix_name"));
+        MyAssert(ZxFS::Filter{ ".PNG", ".A_Very_Long_Suffix_Name" }.SetIgnoreCase(true).SetIgnoreCase(false).IsMatch("x.png") == false && ZxFS::Filter{ ".PNG" }.SetIgnoreCase(true).SetIgnoreCase(false).IsMatch("x.PNG"));
+        const auto self_file_size{ std::filesystem::file_size(self_path_sv) };
+        std::size_t search_entry_count{};
+        ZxFS::Searcher::VisitEntries("searcher_test/", true, true, ZxFS::EntryField::Size | ZxFS::EntryField::MTime, [&](std::string_view /* msPath */, ZxFS::Entry& rfEntry)
+            {
+                MyAssert(rfEntry.IsFile() && rfEntry.GetSize() == self_file_size && rfEntry.GetMTime() > 0);
+                return ++search_entry_count != 0;
+            });
+        MyAssert(search_entry_count == 2);
+        std::size_t walk_entry_count{};
+        for (ZxFS::Walker walk{ "searcher_test/a/", ZxFS::EntryField::Size }; walk.Next(); walk_entry_count++)
+        {
+            MyAssert(walk.GetEntry().IsDir() ? walk.GetName() == "b/" : walk.GetEntry().GetSize() == self_file_size);
+        }
+        MyAssert(walk_entry_count == 2);
+        std::vector<std::string> walk_paths;
+        for (ZxFS::Walker walk{ "searcher_test/", ZxFS::EntryField::None, ZxFS::Walker::ANY_DEPTH }; walk.Next(); )
+        {
+            walk_paths.emplace_back(std::to_string(walk.GetDepth()) + ":" + std::string{ walk.GetPath() });
+            if (walk.GetName() == "b/") { walk.Prune(); }
+        }
+        std::ranges::sort(walk_paths);
+        MyAssert((walk_paths == std::vector<std::string>{ "0:searcher_test/a/", "1:searcher_test/a/b/", "1:searcher_test/a/x.bin" }));
+        walk_paths.clear();
+        for (ZxFS::Walker walk{ "searcher_test/", ZxFS::EntryField::None, ZxFS::Walker::ANY_DEPTH }; walk.NextFile(); ) { walk_paths.emplace_back(walk.GetPath()); }
+        std::ranges::sort(walk_paths);
+        MyAssert((walk_paths == std::vector<std::string>{ "searcher_test/a/b/y.bin", "searcher_test/a/x.bin" }));
+        for (ZxFS::Walker walk{ "searcher_test/a/" }; walk.NextDir(); )
+        {
+            // the walkers above gave their path buffers back, a nested one must not share the outer one's
+            ZxFS::Walker walk_inner{ walk.GetPath() };
+            MyAssert(walk_inner.NextFile() && walk_inner.GetPath() == "searcher_test/a/b/y.bin" && walk.GetPath() == "searcher_test/a/b/");
+        }
+        {
+            // stamps younger than the racy window are never trusted, age the tree first
+            const auto old_time{ std::filesystem::file_time_type::clock::now() - std::chrono::hours{ 1 } };
+            for (const auto dir : { "searcher_test/", "searcher_test/a/", "searcher_test/a/b/" }) { std::filesystem::last_write_time(dir, old_time); }
+
+            ZxFS::ScanIndex scan_index;
+            MyAssert(scan_index.Update("searcher_test/") && scan_index.GetDirCount() == 3 && scan_index.GetReadDirCount() == 3);
+            MyAssert(scan_index.Save("searcher_test.idx"));
+            ZxFS::ScanIndex scan_index_loaded;
+            MyAssert(scan_index_loaded.Load("searcher_test.idx") && scan_index_loaded.Update("searcher_test/") && scan_index_loaded.GetReadDirCount() == 0);
+            std::vector<std::string> index_paths;
+            scan_index_loaded.GetFilePaths(index_paths, true);
+            std::ranges::sort(index_paths);
+            MyAssert(index_paths == search_serial);
+            ZxFS::FileCopy(self_path_sv, "searcher_test/a/z.bin", false);
+            MyAssert(scan_index_loaded.Update("searcher_test/") && scan_index_loaded.GetReadDirCount() == 1 && scan_index_loaded.GetFileCount() == 3);
+            ZxFS::FileDelete("searcher_test/a/z.bin");
+            ZxFS::FileDelete("searcher_test.idx");
+        }
+
+        {
+            ZxFS::Watcher watcher{ "searcher_test/" };
+            MyAssert(watcher.GetFileCount() == 2 && watcher.Contains("a/b/y.bin") && watcher.IsComplete());
+            ZxFS::DirMakeRecursive("searcher_test/w/v/");
+            ZxFS::FileCopy(self_path_sv, "searcher_test/w/v/z.bin", false);
+            while (watcher.Poll(50) != 0) {}
+            MyAssert(watcher.Contains("searcher_test/w/v/z.bin") == false && watcher.Contains("w/v/z.bin") && watcher.GetFileCount() == 3);
+            ZxFS::DirDeleteRecursive("searcher_test/w/");
+            while (watcher.Poll(50) != 0) {}
+            MyAssert(watcher.GetFileCount() == 2 && watcher.ContainsDir("w/") == false);
+        }
+
+        {
+            std::filesystem::create_hard_link("searcher_test/a/x.bin", "searcher_test/a/b/x_link.bin");
+            std::vector<std::pair<std::string, ZxFS::DirUsage>> dir_usages;
+            const auto dir_usage = ZxFS::DirSize("searcher_test/", 4, dir_usages);
+            MyAssert(dir_usage.has_value() && dir_usage->FileCount == 2 && dir_usage->DirCount == 3 && dir_usage->FailedDirCount == 0 && dir_usage->ApparentBytes >= 2 * self_file_size);
+            MyAssert(ZxFS::FileSize("searcher_test/a/x.bin") == self_file_size);
+            const auto dir_usage_b = std::ranges::find(dir_usages, std::string{ "a/b/" }, &std::pair<std::string, ZxFS::DirUsage>::first);
+            MyAssert(dir_usages.size() == 3 && dir_usage_b != dir_usages.end() && dir_usage_b->second.DirCount == 1 && dir_usage_b->second.FileCount <= 2);
+            ZxFS::FileDelete("searcher_test/a/b/x_link.bin");
+        }
+
+        std::vector<std::string> copy_failed_paths;
+        MyAssert(ZxFS::DirCopyRecursive("searcher_test/", "searcher_copy/x/", false, 4, copy_failed_paths) && copy_failed_paths.empty());
+        auto search_copied = ZxFS::Searcher::GetFilePaths("searcher_copy/x/", false, true);
+        auto search_origin = ZxFS::Searcher::GetFilePaths("searcher_test/", false, true);
+        std::ranges::sort(search_copied);
+        std::ranges::sort(search_origin);
+        MyAssert(search_copied == search_origin);
+        MyAssert(ZxFS::DirCopyRecursive("searcher_test/", "searcher_copy/x/", true, 4, copy_failed_paths) == false && copy_failed_paths.size() == 2);
+        copy_failed_paths.clear();
+        std::filesystem::create_symlink("x.bin", "searcher_test/a/x_symlink.bin");
+        MyAssert(ZxFS::DirCopyRecursive("searcher_test/", "searcher_copy/s/", false, 4, copy_failed_paths) == false && copy_failed_paths == std::vector<std::string>{ "searcher_test/a/x_symlink.bin" });
+        std::filesystem::remove("searcher_test/a/x_symlink.bin");
+        const std::vector<std::string> batch_paths{ "searcher_copy/x/a/x.bin", "searcher_copy/x/a/b/y.bin", "searcher_copy/x/none.bin" };
+        const std::vector<std::string> batch_moved{ "searcher_copy/x.bin", "searcher_copy/y.bin" };
+        MyAssert((ZxFS::Exist(batch_paths, 8) == std::vector<bool>{ true, true, false }));
+        const auto batch_sizes{ ZxFS::FileSize(batch_paths, 8) };
+        MyAssert(batch_sizes[0] == self_file_size && batch_sizes[1] == self_file_size && !batch_sizes[2].has_value());
+        MyAssert((ZxFS::FileMove(batch_paths, batch_moved, 8) == std::vector<bool>{ true, true, false }));
+        MyAssert((ZxFS::FileDelete(batch_moved, 8) == std::vector<bool>{ true, true }));
+        MyAssert((ZxFS::Exist(batch_moved, 8) == std::vector<bool>{ false, false }));
+        MyAssert(ZxFS::DirDeleteRecursive("searcher_copy/", 4) == true);
+        MyAssert(ZxFS::DirContentDelete("searcher_test/", 4) == true);
+        MyAssert(ZxFS::Searcher::GetFilePaths("searcher_test/", true, true).empty());
+        MyAssert(ZxFS::DirDeleteRecursive("searcher_test/", 4) == true);
+        MyAssert(ZxFS::Exist("searcher_test/") == false);
 
         [[maybe_unused]] int x = 0;
 